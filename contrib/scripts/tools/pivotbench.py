@@ -0,0 +1,103 @@
+"""
+Times the pivoting solvers on a set of representative games.
+
+usage: pivotbench.py [--repeat N] [--timeout SECS] BINDIR [BINDIR ...]
+
+Each BINDIR is a directory containing the gambit command-line tools,
+for example a build tree before and after a change to the linear
+algebra in src/solvers/linalg.  Every case is run with each set of
+tools in turn; the best of N wall-clock times is reported, together
+with whether the outputs of the tools agree.  Floating-point results
+may legitimately differ in the last printed digit between versions.
+
+The cases exercise the floating-point tableaux (LPTableau, LemkeTableau
+and the vertex enumeration in enummixed), whose bases are factored by
+LUdecomp, on the games in contrib/games and on random strategic games
+of a few sizes, which are written to a temporary directory.
+"""
+
+import argparse
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+GAMES = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                     "..", "..", "games")
+
+CASES = [
+    ("gambit-lp", ["-d", "10"], "ttt.efg"),
+    ("gambit-lp", ["-d", "10"], "cs.efg"),
+    ("gambit-lp", ["-S", "-d", "10"], "e02.nfg"),
+    ("gambit-lcp", ["-S", "-d", "10"], "4cards.efg"),
+    ("gambit-lcp", ["-S", "-d", "10"], "palf2.efg"),
+    ("gambit-lcp", ["-S", "-d", "10"], "myerson.efg"),
+    ("gambit-lcp", ["-e", "1", "-d", "10"], "random-40x40.nfg"),
+    ("gambit-lcp", ["-e", "1", "-d", "10"], "random-80x80.nfg"),
+    ("gambit-lcp", ["-e", "1", "-d", "10"], "random-160x160.nfg"),
+    ("gambit-enummixed", ["-d", "10"], "random-9x9.nfg"),
+]
+
+
+def write_random_nfg(path, rows, cols, seed):
+    """Writes a bimatrix game with integer payoffs drawn uniformly from 0-99"""
+    rng = random.Random(seed)
+    with open(path, "w") as f:
+        f.write('NFG 1 R "Random %dx%d game" { "Player 1" "Player 2" } '
+                '{ %d %d }\n\n' % (rows, cols, rows, cols))
+        f.write(" ".join(str(rng.randint(0, 99))
+                         for _ in range(2 * rows * cols)))
+        f.write("\n")
+
+
+def run(bindir, tool, args, game, timeout):
+    cmd = [os.path.join(bindir, tool), "-q"] + args + [game]
+    start = time.time()
+    try:
+        out = subprocess.run(cmd, capture_output=True, timeout=timeout).stdout
+    except subprocess.TimeoutExpired:
+        return None, None
+    return time.time() - start, out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("bindirs", nargs="+", metavar="BINDIR")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--timeout", type=float, default=120.0)
+    options = parser.parse_args()
+
+    tmpdir = tempfile.mkdtemp()
+    for i, size in enumerate([9, 40, 80, 160]):
+        write_random_nfg(os.path.join(tmpdir, "random-%dx%d.nfg" % (size, size)),
+                         size, size, i)
+
+    print("%-18s %-14s %-20s" % ("tool", "options", "game") +
+          "".join(" %12s" % os.path.basename(os.path.normpath(d))
+                  for d in options.bindirs) + "  agree")
+    for tool, args, name in CASES:
+        game = os.path.join(GAMES, name)
+        if not os.path.exists(game):
+            game = os.path.join(tmpdir, name)
+        times, outputs = [], []
+        for bindir in options.bindirs:
+            best, output = None, None
+            for _ in range(options.repeat):
+                elapsed, output = run(bindir, tool, args, game, options.timeout)
+                if elapsed is None:
+                    break
+                best = elapsed if best is None else min(best, elapsed)
+            times.append(best)
+            outputs.append(output)
+        print("%-18s %-14s %-20s" % (tool, " ".join(args), name) +
+              "".join(" %12s" % ("timeout" if t is None else "%.3f" % t)
+                      for t in times) +
+              "  %s" % ("-" if None in outputs else
+                       "yes" if len(set(outputs)) == 1 else "NO"))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -3,7 +3,7 @@
 // Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
 //
 // FILE: src/libgambit/list.h
-// A generic (doubly) linked-list container class
+// A generic list container class with O(1) indexed access
 //
 // This program is free software; you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -23,85 +23,58 @@
 #ifndef LIBGAMBIT_LIST_H
 #define LIBGAMBIT_LIST_H
 
+#include <deque>
+#include <algorithm>
+#include <type_traits>
+
 namespace Gambit {
 
-/// A doubly-linked list container.
+/// A generic list container.
+///
+/// This was originally implemented as a doubly-linked list, which cached
+/// the last item accessed by indexing via operator[] so that sequential
+/// access was constant-time.  Much of Gambit, and in particular the
+/// solvers, index into lists in arbitrary order, so the elements are now
+/// held in a std::deque.  This gives constant-time indexing in any order,
+/// and stores the elements in fixed-size blocks rather than one heap node
+/// per element.
 ///
-/// This implements a doubly-linked list.  A special feature of this
-/// class is that it caches the last item accessed by indexing via
-/// operator[], meaning that, if accesses are done in sequential order,
-/// indexing time is constant.
+/// References to elements stay valid when elements are added or removed
+/// at either end (Append, push_back, and Insert or Remove at the first or
+/// last position), as they did with the linked list.  Unlike the linked
+/// list, inserting or removing in the middle of the list invalidates
+/// references and iterators to all elements.
 ///
-/// This index-cacheing feature was implemented very early in the development
-/// of Gambit, before STL-like concepts of iterators had been fully
-/// developed.  An iterator approach is a better and more robust solution
-/// to iterating lists, both in terms of performance and encapsulation.
-/// Therefore, it is recommended to avoid operator[] and use the provided
-/// iterator classes in new code, and to upgrade existing code to the
-/// iterator idiom as practical.
+/// Indexing is 1-based, as in the rest of Gambit; the STL-style iterator
+/// interface should be preferred in new code.
 template <class T> class List {
 protected:
-  class Node {
-  public:
-    T m_data;
-    Node *m_prev, *m_next;
-    
-    // CONSTRUCTOR
-    Node(const T &p_data, Node *p_prev, Node *p_next);
-  };
-
-  int m_length;
-  Node *m_head, *m_tail;
-
-  int m_currentIndex;
-  Node *m_currentNode;
+  std::deque<T> m_list;
 
   int InsertAt(const T &t, int where);
+  void InsertAt(const T &t, int where, std::true_type);
+  void InsertAt(const T &t, int where, std::false_type);
+  void RemoveAt(int where, std::true_type);
+  void RemoveAt(int where, std::false_type);
 
 public:
-  class iterator {
-  private:
-    const List &m_list;
-    Node *m_node;
-  public:
-    iterator(const List &p_list, Node *p_node)
-      : m_list(p_list), m_node(p_node)  { }
-    T &operator*() const { return *m_node; }
-    iterator &operator++()  { m_node = m_node->m_next; return *this; }
-    bool operator==(const iterator &it) const
-    { return (m_node == it.m_node); }
-    bool operator!=(const iterator &it) const
-    { return (m_node != it.m_node); }
-  };
+  typedef typename std::deque<T>::iterator iterator;
+  typedef typename std::deque<T>::const_iterator const_iterator;
 
-  class const_iterator {
-  private:
-    const List &m_list;
-    Node *m_node;
-  public:
-    const_iterator(const List &p_list, Node *p_node)
-      : m_list(p_list), m_node(p_node)  { }
-    const T &operator*() const { return *m_node; }
-    const_iterator &operator++()  { m_node = m_node->m_next; return *this; }
-    bool operator==(const const_iterator &it) const
-    { return (m_node == it.m_node); }
-    bool operator!=(const const_iterator &it) const
-    { return (m_node != it.m_node); }
-  };
-
-  List();
-  List(const List<T> &);
-  virtual ~List();
+  List() = default;
+  List(const List<T> &) = default;
+  virtual ~List() = default;
   
-  List<T> &operator=(const List<T> &);
+  List<T> &operator=(const List<T> &b)
+  { std::deque<T> copy(b.m_list); m_list.swap(copy); return *this; }
   
   bool operator==(const List<T> &b) const;
-  bool operator!=(const List<T> &b) const;
+  bool operator!=(const List<T> &b) const { return !(*this == b); }
   
-  iterator begin()             { return iterator(*this, m_head); }
-  const_iterator begin() const { return const_iterator(*this, m_head); }
-  iterator end()               { return iterator(*this, 0); }
-  const_iterator end() const   { return const_iterator(*this, 0); }
+  iterator begin()             { return m_list.begin(); }
+  const_iterator begin() const { return m_list.begin(); }
+  iterator end()               { return m_list.end(); }
+  const_iterator end() const   { return m_list.end(); }
 
   const T &operator[](int) const;
   T &operator[](int);
@@ -115,7 +88,7 @@ public:
 
   int Find(const T &) const;
   bool Contains(const T &t) const;
-  int Length() const { return m_length; }
+  int Length() const { return m_list.size(); }
 
   /// @name STL-style interface
   ///
@@ -125,291 +98,149 @@ public:
   /// possible.
   ///@{
   /// Return whether the list container is empty (has size 0).
-  bool empty() const { return (m_length == 0); }
+  bool empty() const { return m_list.empty(); }
   /// Return the number of elements in the list container.
-  size_t size() const { return m_length; }
+  size_t size() const { return m_list.size(); }
   /// Adds a new element at the end of the list container, after its
   /// current last element.
-  void push_back(const T &val);
+  void push_back(const T &val) { m_list.push_back(val); }
   /// Removes all elements from the list container (which are destroyed),
   /// leaving the container with a size of 0.
-  void clear();
+  void clear() { m_list.clear(); }
   /// Returns a reference to the first elemnet in the list container.
-  T &front()             { return m_head->m_data; }
+  T &front()             { return m_list.front(); }
   /// Returns a reference to the first element in the list container.
-  const T &front() const { return m_head->m_data; }
+  const T &front() const { return m_list.front(); }
   /// Returns a reference to the last element in the list container.
-  T &back()             { return m_tail->m_data; }
+  T &back()             { return m_list.back(); }
   /// Returns a reference to the last element in the list container.
-  const T &back() const { return m_tail->m_data; }
+  const T &back() const { return m_list.back(); }
   ///@}
 };
 
-
-//--------------------------------------------------------------------------
-//                 Node: Member function implementations
-//--------------------------------------------------------------------------
-
-template <class T> 
-List<T>::Node::Node(const T &p_data,
-		    typename List<T>::Node *p_prev, typename List<T>::Node *p_next)
-  : m_data(p_data), m_prev(p_prev), m_next(p_next)
-{ }
-
 //--------------------------------------------------------------------------
 //                 List<T>: Member function implementations
 //--------------------------------------------------------------------------
 
-template <class T> List<T>::List() 
-  : m_length(0), m_head(0), m_tail(0), m_currentIndex(0), m_currentNode(0)
-{ }
-
-template <class T> List<T>::List(const List<T> &b)
-  : m_length(b.m_length)
-{
-  if (m_length)  {  
-    Node *n = b.m_head;
-    m_head = new Node(n->m_data, 0, 0);
-    n = n->m_next;
-    m_tail = m_head;
-    while (n)  { 
-      m_tail->m_next = new Node(n->m_data, m_tail, 0);
-      n = n->m_next;
-      m_tail = m_tail->m_next;
-    }
-    m_currentIndex = 1;
-    m_currentNode = m_head;
-  }
-  else  {
-    m_head = m_tail = 0;
-    m_currentIndex = 0;
-    m_currentNode = 0;
-  }
-}
-
-template <class T> List<T>::~List()
-{
-  Node *n = m_head;
-  while (n)  {
-    Node *m_next = n->m_next;
-    delete n;
-    n = m_next;
-  }
-}
-
 template <class T> int List<T>::InsertAt(const T &t, int num)
 {
-  if (num < 1 || num > m_length + 1)   throw IndexException();
-  
-  if (!m_length)  {
-    m_head = m_tail = new Node(t, 0, 0);
-    m_length = 1;
-    m_currentIndex = 1;
-    m_currentNode = m_head;
-    return m_length;
-  }
-
-  Node *n;
-  int i;
-  
-  if( num <= 1 )  {
-    n = new Node(t, 0, m_head);
-    m_head->m_prev = n;
-    m_currentNode = m_head = n;
-    m_currentIndex = 1;
-  }
-  else if( num >= m_length + 1)  {
-    n = new Node(t, m_tail, 0);
-    m_tail->m_next = n;
-    m_currentNode = m_tail = n;
-    m_currentIndex = m_length + 1;
+  if (num < 1 || num > Length() + 1)   throw IndexException();
+  if (num == 1) {
+    m_list.push_front(t);
   }
-  else  {
-    if( num < m_currentIndex )
-      for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-    else
-      for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-    n = new Node(t, n->m_prev, n);
-    m_currentNode = n->m_prev->m_next = n->m_next->m_prev = n;
-    m_currentIndex = num;
+  else {
+    InsertAt(t, num, std::is_copy_assignable<T>());
   }
-
-  m_length++;
   return num;
 }
 
-//--------------------- visible functions ------------------------
-
-template <class T> List<T> &List<T>::operator=(const List<T> &b)
+template <class T>
+void List<T>::InsertAt(const T &t, int num, std::true_type)
 {
-  if (this != &b)   {
-    Node *n = m_head;
-    while (n) {
-      Node *m_next = n->m_next;
-      delete n;
-      n = m_next;
-    }
+  m_list.insert(m_list.begin() + (num - 1), t);
+}
 
-    m_length = b.m_length;
-    m_currentIndex = b.m_currentIndex;
-    if (m_length)   {
-      Node *n = b.m_head;
-      m_head = new Node(n->m_data, 0, 0);
-      if (b.m_currentNode == n) m_currentNode = m_head;
-      n = n->m_next;
-      m_tail = m_head;
-      while (n)  {
-	m_tail->m_next = new Node(n->m_data, m_tail, 0);
-	if (b.m_currentNode == n) m_currentNode = m_tail->m_next;
-	n = n->m_next;
-	m_tail = m_tail->m_next;
-      }
-    }
-    else
-      m_head = m_tail = 0;
+// Element types without an assignment operator cannot be shifted in
+// place, so the tail of the list is rebuilt by copy-construction.
+template <class T>
+void List<T>::InsertAt(const T &t, int num, std::false_type)
+{
+  std::deque<T> tail(m_list.begin() + (num - 1), m_list.end());
+  while (Length() >= num)  m_list.pop_back();
+  m_list.push_back(t);
+  for (const_iterator it = tail.begin(); it != tail.end(); ++it) {
+    m_list.push_back(*it);
   }
-  return *this;
 }
 
 template <class T> bool List<T>::operator==(const List<T> &b) const
 {
-  if (m_length != b.m_length) return false;
-  for (Node *m = m_head, *n = b.m_head; m; m = m->m_next, n = n->m_next)
-    if (m->m_data != n->m_data)  return false;
+  if (Length() != b.Length()) return false;
+  for (int i = 0, n = Length(); i < n; i++)
+    if (m_list[i] != b.m_list[i])  return false;
   return true;
 }
 
-template <class T> bool List<T>::operator!=(const List<T> &b) const
-{
-  return !(*this == b);
-}
-
 template <class T> const T &List<T>::operator[](int num) const
 {
-  if (num < 1 || num > m_length)    throw IndexException();
-
-  int i;
-  Node *n;
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-  return n->m_data;
+  if (num < 1 || num > Length())    throw IndexException();
+  return m_list[num - 1];
 }
 
 template <class T> T &List<T>::operator[](int num)
 {
-  if (num < 1 || num > m_length)   throw IndexException();
-  Node *n;
-  int i;
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-  m_currentIndex = i;
-  m_currentNode = n;
-  return n->m_data;
+  if (num < 1 || num > Length())   throw IndexException();
+  return m_list[num - 1];
 }
 
 template <class T> List<T> List<T>::operator+(const List<T> &b) const
 {
   List<T> result(*this);
-  Node *n = b.m_head;
-  while (n)  {
-    result.Append(n->data);
-    n = n->m_next;
-  }
+  result += b;
   return result;
 }
 
 template <class T> List<T> &List<T>::operator+=(const List<T> &b)
 {
-  Node *n = b.m_head;
-  
-  while (n)  {
-    Append(n->m_data);
-    n = n->m_next;
+  for (int i = 1, n = b.Length(); i <= n; i++) {
+    m_list.push_back(b.m_list[i - 1]);
   }
   return *this;
 }
 
 template <class T> int List<T>::Append(const T &t)
 {
-  return InsertAt(t, m_length + 1);
+  m_list.push_back(t);
+  return Length();
 }
 
 template <class T> int List<T>::Insert(const T &t, int n)
 {
-  return InsertAt(t, (n < 1) ? 1 : ((n > m_length + 1) ? m_length + 1 : n));
+  return InsertAt(t, (n < 1) ? 1 : ((n > Length() + 1) ? Length() + 1 : n));
 }
 
 template <class T> T List<T>::Remove(int num)
 {
-  if (num < 1 || num > m_length)   throw IndexException();
-  Node *n;
-  int i;
-
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-
-  if (n->m_prev)
-    n->m_prev->m_next = n->m_next;
-  else
-    m_head = n->m_next;
-  if (n->m_next)
-    n->m_next->m_prev = n->m_prev;
-  else
-    m_tail = n->m_prev;
-
-  m_length--;
-  m_currentIndex = i;
-  m_currentNode = n->m_next;
-  if (m_currentIndex > m_length) {
-    m_currentIndex = m_length;
-    m_currentNode = m_tail;
+  if (num < 1 || num > Length())   throw IndexException();
+  T ret = m_list[num - 1];
+  if (num == 1) {
+    m_list.pop_front();
+  }
+  else if (num == Length()) {
+    m_list.pop_back();
+  }
+  else {
+    RemoveAt(num, std::is_copy_assignable<T>());
   }
-  T ret = n->m_data;
-  delete n;
   return ret;
 }
 
-template <class T> int List<T>::Find(const T &t) const
+template <class T> void List<T>::RemoveAt(int num, std::true_type)
 {
-  if (m_length == 0)  return 0;
-  Node *n = m_head;
-  for (int i = 1; n; i++, n = n->m_next)
-    if (n->m_data == t)   return i;
-  return 0;
+  m_list.erase(m_list.begin() + (num - 1));
 }
 
-template <class T> bool List<T>::Contains(const T &t) const
+// As in InsertAt, the tail is rebuilt when elements cannot be assigned.
+template <class T> void List<T>::RemoveAt(int num, std::false_type)
 {
-  return (Find(t) != 0);
+  std::deque<T> tail(m_list.begin() + num, m_list.end());
+  while (Length() >= num)  m_list.pop_back();
+  for (const_iterator it = tail.begin(); it != tail.end(); ++it) {
+    m_list.push_back(*it);
+  }
 }
 
-template <class T> void List<T>::push_back(const T &val)
+template <class T> int List<T>::Find(const T &t) const
 {
-  InsertAt(val, m_length + 1);
+  typename std::deque<T>::const_iterator it = std::find(m_list.begin(), m_list.end(), t);
+  return (it == m_list.end()) ? 0 : (it - m_list.begin()) + 1;
 }
 
-template <class T> void List<T>::clear()
+template <class T> bool List<T>::Contains(const T &t) const
 {
-  Node *n = m_head;
-  while (n)  {
-    Node *m_next = n->m_next;
-    delete n;
-    n = m_next;
-  }
-  m_length = 0;
-  m_head = 0;
-  m_tail = 0;
-  m_currentIndex = 0;
-  m_currentNode = 0;
+  return (Find(t) != 0);
 }
 
 }
 
 #endif // LIBGAMBIT_LIST_H
-
@@ -62,7 +62,6 @@ Porder(Po),
 Pr(P),
 isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
-cache(numPlayers+1),
 player2Class(numPlayers),
 kSymStrategyOffset(1,0)
 {
@@ -133,6 +132,25 @@ kSymStrategyOffset(1,0)
     for(int j=0;j<actions[i];j++)
 	node2Action[actionSets[i][j]][i]=j;
 
+  //set up the caches of getV
+  projectedFrom.assign(numANodes, vector<AggNumberVector>(numPlayers));
+  prefixCache.resize(numPlayers);
+  prefixValid.resize(numPlayers);
+  suffixCache.resize(numPlayers);
+  suffixValid.resize(numPlayers);
+  valueCache.resize(numPlayers);
+  PorderPos.resize(numPlayers);
+  for(int i=0;i<numPlayers;i++){
+    prefixCache[i].resize(actions[i]);
+    prefixValid[i].assign(actions[i],0);
+    suffixCache[i].resize(actions[i]);
+    suffixValid[i].assign(actions[i],numPlayers);
+    valueCache[i].assign(actions[i],0.0);
+    PorderPos[i].assign(actions[i],vector<int>(numPlayers));
+    for(int j=0;j<actions[i];j++)
+      for(int k=0;k<numPlayers;k++)
+	PorderPos[i][j][Porder[i][j][k]]=k;
+  }
 }
 
 /*
@@ -580,37 +598,6 @@ AGG::initPorder(vector<int>& Po,
 
 
 
-//compute the induced distribution 
-void
-AGG::computeP(int player, int act, int player2,int act2)
-{
-  //apply player's strat
-  Pr[0].reset();
-  Pr[0].insert(make_pair(projection[actionSets[player][act]][player][act], 1.0) );
-
-  int numNei = neighbors[actionSets[player][act]].size();
-  //apply others' strat
-  for (int k=1; k<numPlayers;k++){
-    Pr[k].reset();
-    if (Porder[player][act][k]==player2){ 
-      if (act2==-1){
-	//Pr[k].swap(Pr[k-1]);
-	Pr[k]=Pr[k-1];
-      } else {
-	//apply player2's pure strat
-	aggdistrib temp;
-	temp.insert(make_pair(projection[actionSets[player][act]][player2][act2],1.0));
-	Pr[k].multiply(Pr[k-1],temp ,numNei, projFunctions[actionSets[player][act]]);
-      }
-    } else {
-      Pr[k].multiply (Pr[k-1], 
-	projectedStrat[actionSets[player][act]][Porder[player][act][k]],
-	numNei  ,projFunctions[actionSets[player][act]] ); 
-    }
-  }
-    
-}
-
 void AGG:: doProjection(int Node, AggNumber* s)
 {
   for (int i=0;i<numPlayers;i++){
@@ -618,13 +605,93 @@ void AGG:: doProjection(int Node, AggNumber* s)
   }
 }
 
+//the projection is skipped if i's strategy is the one last projected
 void AGG:: doProjection(int Node, int i, AggNumber* s)
 {
+  AggNumberVector &from = projectedFrom[Node][i];
+  if ((int)from.size()==actions[i] && equal(from.begin(),from.end(),s)) return;
+  invalidateProjection(Node,i);
   projectedStrat[Node][i].reset();
   for (int j=0;j<actions[i];j++)if(s[j]>(AggNumber)0.0){
     projectedStrat[Node][i]+= make_pair(projection[Node][i][j],
               s[j]);
   }
+  from.assign(s,s+actions[i]);
+}
+
+void AGG::invalidateProjection(int Node, int player)
+{
+  projectedFrom[Node][player].clear();
+  //P_k of j's action act depends on player's strategy from the position
+  //of player in Porder[j][act] on, and W_k up to it
+  for (int j=0;j<numPlayers;j++){
+    int act=node2Action[Node][j];
+    if (j==player || act<0) continue;
+    int pos=PorderPos[j][act][player];
+    if (prefixValid[j][act]>pos) prefixValid[j][act]=pos;
+    if (suffixValid[j][act]<=pos) suffixValid[j][act]=pos+1;
+  }
+}
+
+const aggdistrib& AGG::getCachedP(int player, int act)
+{
+  vector<aggdistrib> &P = prefixCache[player][act];
+  int &valid = prefixValid[player][act];
+  int node = actionSets[player][act];
+  int numNei = neighbors[node].size();
+  if (P.empty()){
+    P.resize(numPlayers);
+    valid=0;
+  }
+  if (valid==0){
+    //apply player's strat
+    P[0].reset();
+    P[0].insert(make_pair(projection[node][player][act], 1.0));
+    valid=1;
+  }
+  //apply the strats of the others from the first out-of-date one
+  for (; valid<numPlayers; valid++){
+    P[valid].multiply(P[valid-1], projectedStrat[node][Porder[player][act][valid]],
+		      numNei, projFunctions[node]);
+  }
+  return P[numPlayers-1];
+}
+
+const aggpayoff& AGG::getCachedW(int player, int act, int k)
+{
+  int node = actionSets[player][act];
+  if (k>=numPlayers) return payoffs[node];
+  vector<aggpayoff> &W = suffixCache[player][act];
+  int &valid = suffixValid[player][act];
+  int numNei = neighbors[node].size();
+  if (W.empty()){
+    //the configurations which agents o_0..o_{k-1} can produce
+    W.resize(numPlayers);
+    W[1].insert(make_pair(projection[node][player][act], 1.0));
+    for (int j=2; j<numPlayers; j++){
+      W[j].multiply(W[j-1], fullProjectedStrat[node][Porder[player][act][j-1]],
+		    numNei, projFunctions[node]);
+    }
+    valid=numPlayers;
+  }
+  //take the expectations over the strats of the others, from the last
+  //out-of-date one back to o_k
+  for (; valid>k; valid--){
+    const aggpayoff &next = (valid<numPlayers) ? W[valid] : payoffs[node];
+    W[valid-1].expectation(next, projectedStrat[node][Porder[player][act][valid-1]],
+			   numNei, projFunctions[node]);
+  }
+  return W[k];
+}
+
+AggNumber AGG::getCachedJ(int player, int act, int player2, int act2)
+{
+  int node = actionSets[player][act];
+  int k = PorderPos[player][act][player2];
+  getCachedP(player,act);
+  const aggpayoff &W = getCachedW(player,act,k+1);
+  return prefixCache[player][act][k-1].inner_prod(projection[node][player2][act2],
+			neighbors[node].size(), projFunctions[node], W);
 }
 AggNumber AGG::getPurePayoff(int player, std::vector<int> &s){
   assert(player>=0 && player < numPlayers);
@@ -666,18 +733,32 @@ void AGG::getPayoffVector(AggNumberVector &dest, int player,const StrategyProfil
     }
 }
 
+//getV: the expected payoff of player's action act under s.  The
+//distribution and the payoff are cached for each action, and recomputed
+//only as far as the strategies of the other players have changed since
+//the last call, so that a change in one player's strategy leaves that
+//player's own payoffs cached.
 AggNumber AGG::getV(int player, int act,const StrategyProfile &s){
+    int node=actionSets.at(player).at(act);
     //project s to the projectedStrat
-    doProjection(actionSets.at(player).at(act), s);
-    computeP(player, act);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player][act]]);
+    for (int i=0;i<numPlayers;i++) if (i!=player) doProjection(node,i,s);
+    if (prefixValid[player][act]<numPlayers){
+      valueCache[player][act]=getCachedP(player,act).inner_prod(payoffs[node]);
+    }
+    return valueCache[player][act];
 }
 
+//getJ: the expected payoff of player1's action act1 when player2 plays
+//act2.  It combines the distribution induced by the agents before player2
+//in Porder with the expected payoffs over the agents after player2, both
+//of which are cached, so that the entries for all player2 share a single
+//pass in each direction.
 AggNumber AGG::getJ(int player1, int act1, int player2,int act2,StrategyProfile &s)
 {
-    doProjection(actionSets[player1][act1],s);
-    computeP(player1,act1,player2,act2);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player1][act1]]);
+    int node=actionSets[player1][act1];
+    doProjection(node,s);
+    if (player2==player1) return getCachedP(player1,act1).inner_prod(payoffs[node]);
+    return getCachedJ(player1,act1,player2,act2);
 }
 
 //getSymMixedPayoff: compute expected payoff under a symmetric mixed strat,
@@ -729,7 +810,7 @@ AggNumber AGG::getSymMixedPayoff(int node, StrategyProfile &s)
 {
     int numNei = neighbors[node].size();
 
-    if(!isPure[node]){ // then compute EU using trie_map::power()
+    if(!isPure[node]){ // then compute EU using config_map::power()
       doProjection(node,0,s);
       assert(numPlayers>1);
       //aggdistrib *dest;
@@ -805,6 +886,7 @@ void AGG::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int
 
     if(!isPure[node]){
       int player = playerClasses[plClass].at(0);
+      invalidateProjection(node,player);
       projectedStrat[node][player].reset();
       if(numPl>0){
         for (int j=0;j<actions[player];j++)if(s[j]>(AggNumber)0.0){
@@ -1030,7 +1112,7 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
 
 
 	//insert
-	pair<trie_map<AggNumber>::iterator, bool> r = pay.insert(make_pair(key,u));
+	pair<config_map<AggNumber>::iterator, bool> r = pay.insert(make_pair(key,u));
 	if (!r.second){
 	    cerr<<"WARNING: overwriting utility at [";
 	    copy(key.begin(),key.end(), ostream_iterator<int>(cerr, " "));
@@ -1044,7 +1126,7 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
     //check
     for(auto it = temp.begin(); it!=temp.end(); ++it){
 
-	//pair<trie_map<AggNumber>::iterator,bool> res = pay.insert( *it);
+	//pair<config_map<AggNumber>::iterator,bool> res = pay.insert( *it);
 	
 	if (pay.count(it->first)==0){
 	    cerr<<"ERROR: utility at [";
@@ -29,7 +29,7 @@
 #include <vector>
 #include <iterator>
 #include "proj_func.h"
-#include "trie_map.h"
+#include "config_map.h"
 
 namespace Gambit {
 
@@ -55,11 +55,11 @@ namespace agg {
 
 //data structure for payoff function:
 //alternatively: typedef map<std::vector<int> , AggNumber> aggpayoff;
-typedef trie_map<AggNumber> aggpayoff;
+typedef config_map<AggNumber> aggpayoff;
 
 
 //data struct for prob distribution over configurations:
-typedef trie_map<AggNumber> aggdistrib;
+typedef config_map<AggNumber> aggdistrib;
 
 //types of input formats for payoff func
 typedef enum{COMPLETE,MAPPING,ADDITIVE} payofftype; 
@@ -257,13 +257,7 @@ private:
   // in which we apply the DP algorithm
   std::vector< std::vector< std::vector<int> > > Porder;
 
-  //when computing the induced distribution via ComputeP():
-  //foreach k<= n-1,  
-  //prob. distrib P_k induced by the partial strat profile of agents o_1..o_k
-
-  //when computing the partial distributions for the payoff jacobian:
-  //  foreach  j \in N,
-  // the partial distribution induced by all agents except j. 
+  //scratch distributions, for the symmetric and k-symmetric payoffs
   std::vector<aggdistrib>  Pr;
 
   //foreach s in S, whether s's neighbors are all action nodes
@@ -273,7 +267,36 @@ private:
   std::vector<std::vector<int> > node2Action;
 
   //cache of jacobian entries.
-  trie_map<AggNumber> cache;
+  config_map<AggNumber> cache;
+
+  //foreach s in S, i in N, the strategy of i from which projectedStrat[s][i]
+  //was computed; empty if it is not known
+  std::vector<std::vector<AggNumberVector> > projectedFrom;
+
+  //foreach i in N, s_i in S_i, the distributions P_0..P_{n-1} computed by
+  //computeP(i,s_i) from the current projected strategies, allocated on
+  //first use, and the number of them which are still valid.  Since P_k
+  //only depends on the strategies of agents o_1..o_k, a change in the
+  //strategy of agent o_k leaves P_0..P_{k-1} valid.
+  std::vector<std::vector<std::vector<aggdistrib> > > prefixCache;
+  std::vector<std::vector<int> > prefixValid;
+
+  //foreach i in N, s_i in S_i, the functions W_1..W_{n-1}: W_k maps each
+  //configuration which agents o_0..o_{k-1} can produce to the expected
+  //payoff of s_i given that configuration, over the strategies of agents
+  //o_k..o_{n-1}; W_n is the payoff function itself.  They are allocated
+  //on first use, and W_k is valid for k at least suffixValid[i][s_i].
+  //The jacobian entry of j playing s_j is the expectation of W_{k+1}
+  //under P_{k-1} with s_j applied, where k is the position of j.
+  std::vector<std::vector<std::vector<aggpayoff> > > suffixCache;
+  std::vector<std::vector<int> > suffixValid;
+
+  //foreach i in N, s_i in S_i, the expected payoff of s_i, valid when
+  //all of prefixCache[i][s_i] is
+  std::vector<std::vector<AggNumber> > valueCache;
+
+  //foreach i in N, s_i in S_i, j in N, the position of j in Porder[i][s_i]
+  std::vector<std::vector<std::vector<int> > > PorderPos;
 
   //the unique action sets
   std::vector<ActionSet> uniqueActionSets;
@@ -337,7 +360,6 @@ private:
 
 
   //private methods:
-  void computeP(int player, int act, int player2=-1,int act2=-1);
   void doProjection(int Node,const StrategyProfile& s){
 	  doProjection (Node, &(const_cast<StrategyProfile &>(s)[0]));
   }
@@ -346,6 +368,17 @@ private:
   }
   void doProjection(int Node, AggNumber* s);
   void doProjection(int Node, int player, AggNumber* s);
+  //marks the cached distributions which use projectedStrat[Node][player]
+  //as out of date
+  void invalidateProjection(int Node, int player);
+  //the distribution induced by player playing act and the others' projected
+  //strategies, from the cache
+  const aggdistrib& getCachedP(int player, int act);
+  //W_k of player's action act, from the cache
+  const aggpayoff& getCachedW(int player, int act, int k);
+  //the payoff of player playing act when player2 plays act2, and the
+  //others their projected strategies, from the caches
+  AggNumber getCachedJ(int player, int act, int player2, int act2);
 
   void getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
 };
@@ -0,0 +1,473 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//                          Albert Xin Jiang <albertjiang@gmail.com>
+//
+// FILE: src/games/agg/config_map.h
+// Hashed map from configurations, with STL-like interfaces
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_AGG_CONFIGMAP_H
+#define GAMBIT_AGG_CONFIGMAP_H
+
+//Mapping from vector of ints to type V.
+//The entries are kept in one array, in order of insertion, and indexed
+//by an open-addressing hash table on the keys.  reset() keeps both the
+//array and the table, so that a map which is refilled repeatedly does
+//not allocate once it has reached its largest size.
+//WARNING: traversal using the iterators is in the reverse order of insertion.
+
+#include <cmath>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "proj_func.h"
+
+namespace Gambit {
+
+namespace agg {
+
+//forward declarations
+
+template <class V>
+class config_map;
+
+template <class V>
+std::ostream& operator<< (std::ostream& s, const config_map<V>& t);
+
+
+template <class V> class config_map {
+public:
+  //typedefs
+  typedef std::vector<int>          key_type;
+  typedef std::pair<std::vector<int>, V> value_type;
+
+  typedef V* 		pointer;
+  typedef V&		reference;
+
+  typedef unsigned int  size_type;
+
+  typedef std::reverse_iterator<typename std::vector<value_type>::iterator> iterator;
+  typedef std::reverse_iterator<typename std::vector<value_type>::const_iterator> const_iterator;
+
+
+  //friends
+  friend std::ostream& operator<< <V>(std::ostream& s, const config_map<V>& t);
+
+  //constructors
+  config_map():m_size(0),m_shift(0) {}
+
+  //copy constructor
+  config_map(const config_map<V>& other);
+
+  //destructor
+  virtual ~config_map() {}
+
+  //assignment
+  inline config_map<V>& operator=( const config_map<V>& other);
+
+  inline void swap (config_map<V>& other);
+
+  inline size_type size() const {return m_size;}
+  inline bool empty() const {return m_size==0;}
+  inline iterator begin() {return iterator(m_data.begin()+m_size);}
+  inline iterator end() {return iterator(m_data.begin());}
+  inline const_iterator begin() const {return const_iterator(m_data.begin()+m_size);}
+  inline const_iterator end() const {return const_iterator(m_data.begin());}
+
+  //insert: same interface as in STL map
+  inline std::pair<iterator,bool> insert (const value_type& x){
+    std::pair<size_type,bool> r=insertKey(x.first, x.second);
+    return std::pair<iterator,bool>(at(r.first), r.second);
+  }
+
+  template <class InputIterator>
+  inline void insert(InputIterator f, InputIterator l){
+    for (InputIterator p=f; p != l; ++p){
+	insert( *p);
+    }
+  }
+
+  //insert or add
+  inline config_map<V>& operator+=(const value_type& x){
+    std::pair<size_type,bool> r=insertKey(x.first, x.second);
+    if (!r.second) m_data[r.first].second += x.second;
+    return (*this);
+  }
+
+  //exact matching
+  inline iterator find (const key_type& k){
+    int i=locate(k);
+    return (i>=0)?at(i):end();
+  }
+  inline const_iterator find (const key_type& k) const{
+    int i=locate(k);
+    return (i>=0)?const_iterator(m_data.begin()+i+1):end();
+  }
+  inline iterator findExact (const key_type& k){return find(k);}
+
+  //clear the data, releasing the storage
+  inline void clear(){
+    m_data.clear();
+    m_slot.clear();
+    m_table.clear();
+    m_scratch.clear();
+    m_size=0;
+    m_shift=0;
+  }
+
+  //clear data, but keep the storage
+  inline void reset(){
+    for (size_type i=0;i<m_size;++i) m_table[m_slot[i]]=-1;
+    m_size=0;
+  }
+
+  //number of elements with key exactly k.
+  // returns 1 or 0
+  inline size_type count(const key_type& k) const {return (locate(k)>=0);}
+
+  //in order traversal: f is applied to each element in lexicographic
+  //order of the keys
+  template <class UnaryFunction>
+  inline void in_order(UnaryFunction f){
+    std::vector<size_type> order;
+    sortedOrder(order);
+    for (size_t i=0;i<order.size();++i) f(at(order[i]));
+  }
+  inline void print_in_order (){in_order(print_helper());}
+
+  //polynomial multiplication of t1 and t2, store the result in self
+  void multiply (const config_map<V>& t1,const config_map<V>& t2,size_t keylen,
+	 std::vector<proj_func*>& f)
+  {
+    static std::pair<std::vector<int>, V> v;
+    const_iterator p1,p2;
+    //assert(this!=&t1 && this != &t2);
+    bool additive=isAdditive(keylen,f);
+    v.first.resize(keylen);
+    reset();
+    for (p1=t1.begin(); p1!=t1.end(); ++p1)if((*p1).second>(V)0){
+      for(p2=t2.begin(); p2!=t2.end(); ++p2)if((*p2).second>(V)0){
+	combine(v.first.data(), (*p1).first.data(), (*p2).first.data(), keylen, f, additive);
+	v.second = (V)((*p1).second * (*p2).second);
+	(*this) += v;
+      }//end for(p2
+    }//end for(p1
+  }
+
+  //polynomial multiplication
+  //Taken from SEM
+  //Do simplification when V is a class of symbolic expressions and there is strict independence
+  //However, wouldn't it be sufficient to check if projectedStrat is a singleton?
+  void multiply_smart (const config_map<V>& P_k_minus_1,const config_map<V>& projectedStrat,size_t keylen,
+                        std::vector<proj_func*>& f)
+        {
+                static std::pair<std::vector<int>, V> v;
+                v.first.resize(keylen);
+                reset();
+
+                for (const_iterator P_c_kminus1=P_k_minus_1.begin(); P_c_kminus1!=P_k_minus_1.end(); ++P_c_kminus1)if((*P_c_kminus1).second>V(0)) {
+                        /*
+                         take c_{k-1}, and apply the first a_k to it to get an updated
+                         configuration c_k.  Then you'd apply every other a_k' to c_{k-1} and
+                         see if it equals c_k.  If not, you'd break out of the check and do the
+                         usual "for a_k" loop.  If every a_k' leads to c_k, then you can just
+                         update Pk[c_k] += P_{k-1}[c_{k-1}]
+                         */
+                        bool canSimplify = true;
+                        std::vector<int> prevConfigObtained(keylen);
+                        const_iterator a_k = projectedStrat.begin();
+                        for (size_t i=0;i<keylen;++i) {
+                                prevConfigObtained[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
+                                v.first[i] = prevConfigObtained[i];
+                        }
+                        a_k++;
+                        for(; a_k!=projectedStrat.end(); a_k++)
+                        {
+                                if((*a_k).second> V(0)) { // FIXME what if played with prob 0????
+                                        for (size_t i=0;i<keylen;++i) {
+                                                v.first[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
+                                                if( v.first[i] != prevConfigObtained[i] ) {
+                                                        canSimplify = false;
+                                                        break;
+                                                }
+                                        }
+                                        if( !canSimplify )break;
+                                }
+                        }
+                        if( canSimplify ){
+                                // v.first should already be initialized
+                                v.second = (V)(*P_c_kminus1).second;
+                                (*this) += v;
+                        }else{
+                                for(const_iterator a_k=projectedStrat.begin(); a_k!=projectedStrat.end(); ++a_k)if((*a_k).second>V(0)) {
+                                        for (size_t i=0;i<keylen;++i) {
+                                                v.first[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
+                                        }
+                                        v.second = (V)((*P_c_kminus1).second * (*a_k).second); // this is the 'value'
+                                        (*this) += v;
+                                }//end for(p2
+                        }
+                }//end for(p1
+        }
+
+  //multiply in-place. other should not be the same object as self.
+  void multiply (const config_map<V>& other,size_t keylen, std::vector<proj_func*>& f);
+
+  //squaring
+  void square(config_map<V>& dest, size_t keylen, std::vector<proj_func*>& f) const{
+    static std::pair<std::vector<int>, V> v;
+    bool additive=isAdditive(keylen,f);
+    v.first.resize(keylen);
+    //assert(this!=&dest);
+    dest.reset();
+    for (const_iterator p1=begin(); p1!=end(); ++p1)if((*p1).second>(V)0){
+      for(const_iterator p2=p1; p2!=end(); ++p2)if((*p2).second>(V)0){
+	combine(v.first.data(), (*p1).first.data(), (*p2).first.data(), keylen, f, additive);
+        v.second = (V)((*p1).second * (*p2).second);
+        if(p1!=p2)v.second *=2;
+        dest += v;
+      }//end for(p2
+    }//end for(p1
+  }
+
+  //squaring in-place
+  void square(size_t keylen, std::vector<proj_func*>& f);
+
+  //take power of self using repeated squaring. result stored in dest.
+  //this is actually slower than power by straight multiplication, if the # of configurations grow polynomially
+  //in the # of players.
+  void power_repsq (size_t p, config_map<V>& dest, size_t keylen, std::vector<proj_func*>& f) const{
+    //assert(p>0 && this!=&dest );
+    if(p==1){
+      dest=*this;
+      return;
+    }
+    if(p<=3){
+      //dest.multiply(*this, *this, keylen, f);
+      square(dest,keylen,f);
+      if(p==3)dest.multiply(*this,keylen,f);
+      return;
+    }
+    //power( p/2, scratch,dest, keylen, f);
+    power_repsq( p/2,dest, keylen, f);
+    //dest.multiply(scratch,scratch, keylen,f);
+    dest.square(keylen,f); //take the square of scratch, store in dest
+
+    if(p%2==1){
+      dest.multiply(*this, keylen,f);
+    }
+  }
+
+  void power(size_t p, config_map<V> &dest,config_map<V> &scratch, size_t keylen, std::vector<proj_func*> &f){
+    //assert(p>0 && this!=&dest );
+    if (p==1) {
+      dest = *this;
+      return;
+    }
+    square(dest,keylen,f);
+    p-=2;
+    if (p>1)scratch=dest;
+    while(p>0){
+      if(p==1){
+        dest.multiply(*this,keylen,f);
+        return;
+      }
+      dest.multiply(scratch,keylen,f);
+      p-=2;
+    }
+
+  }
+
+  //inner product
+  V inner_prod( const config_map<V>& other, V init= (V)(0) ) const{
+    V result(init);
+    //V th(THRESH);
+    for(const_iterator p=begin(); p!=end(); ++p)if((*p).second>(V)0){
+	int i=other.locate((*p).first);
+	if (i<0){
+	  if(p->second>(V) THRESH){
+	    std::cout<<"inner_prod WARNING: discarding [";
+	    copy(p->first.begin(),p->first.end(), std::ostream_iterator<int>(std::cout," "));
+	    std::cout<<"] "<<p->second<<std::endl;
+	  }
+	}
+	else {
+	  result+= (*p).second * other.m_data[i].second;
+	}
+    }
+    return result;
+  }
+
+  //first apply the action x, then inner prod
+  V inner_prod(const std::vector<int>& x, size_t keylen, std::vector<proj_func*>& f,
+	const config_map<V>& other, V init=(V)(0) ) const
+  {
+    V result(init);
+    V th(THRESH);
+    static std::vector<int> y;
+    bool additive=isAdditive(keylen,f);
+    y.resize(keylen);
+    for (const_iterator p=begin(); p!=end();++p)if((*p).second>(V)0){
+      combine(y.data(), (*p).first.data(), x.data(), keylen, f, additive);
+
+      int i=other.locate(y);
+      if (i<0){
+        if((*p).second>th){
+	  std::cout<<"inner_prod WARNING: discarding [";
+	  copy(y.begin(),y.end(), std::ostream_iterator<int>(std::cout," "));
+	  std::cout<<"] "<<(*p).second<<std::endl;
+        }
+      }
+      else{
+        result += (*p).second  * other.m_data[i].second;
+      }
+    }
+    return result;
+  }
+
+  //sets the value of each key c to the expectation of other at c combined
+  //with a key drawn from distrib.  keys missing from other count as 0.
+  void expectation(const config_map<V>& other, const config_map<V>& distrib,
+		   size_t keylen, std::vector<proj_func*>& f)
+  {
+    static std::vector<int> y;
+    bool additive=isAdditive(keylen,f);
+    y.resize(keylen);
+    for (size_type k=0; k<m_size; ++k){
+      V result(0);
+      for (const_iterator p=distrib.begin(); p!=distrib.end(); ++p)if((*p).second>(V)0){
+	combine(y.data(), m_data[k].first.data(), (*p).first.data(), keylen, f, additive);
+	int i=other.locate(y);
+	if (i>=0) result += (*p).second * other.m_data[i].second;
+      }
+      m_data[k].second=result;
+    }
+  }
+
+
+  //polynomial division
+  inline config_map<V>& operator/= (const std::vector<V>& denom);
+
+
+private:
+  //member variables:
+
+  //the entries in order of insertion; those from m_size on are unused,
+  //and kept so that their keys' storage can be reused
+  std::vector<value_type> m_data;
+  size_type m_size;
+  //the slot of m_table holding each entry
+  std::vector<size_t> m_slot;
+  //open-addressing table of indices into m_data, -1 for an empty slot;
+  //its size is a power of two, 2^(64-m_shift), at least twice m_size
+  std::vector<int> m_table;
+  int m_shift;
+  //the entries being read by an operation in place
+  std::vector<value_type> m_scratch;
+
+  static const double  THRESH;
+
+
+  struct print_helper {
+   void operator()(typename config_map<V>::iterator p){
+    std::cout<<"[";
+    copy(p->first.begin(),p->first.end(),std::ostream_iterator<int>(std::cout," "));
+    std::cout <<"]: "<<p->second<<std::endl;
+   }
+  };
+
+
+  //private methods:
+  inline iterator at(size_type i){return iterator(m_data.begin()+i+1);}
+
+  static inline size_t hash(const key_type& k){
+    unsigned long long h=k.size();
+    for (size_t i=0;i<k.size();++i) h=(h^(unsigned int)k[i])*0x100000001b3ULL;
+    return (size_t)h;
+  }
+  inline size_t home(const key_type& k) const{
+    return (size_t)(((unsigned long long)hash(k)*0x9e3779b97f4a7c15ULL)>>m_shift);
+  }
+
+  //the index of the entry with key k, or -1
+  inline int locate(const key_type& k) const{
+    if (m_table.empty()) return -1;
+    size_t mask=m_table.size()-1;
+    for (size_t s=home(k); m_table[s]>=0; s=(s+1)&mask){
+      if (m_data[m_table[s]].first==k) return m_table[s];
+    }
+    return -1;
+  }
+
+  //inserts the key with value v if it is not present; returns the index
+  //of the entry with the key, and whether it was inserted
+  inline std::pair<size_type,bool> insertKey(const key_type& k, const V& v);
+
+  //rebuilds the table, with at least the given number of slots
+  void rehash(size_t slots);
+
+  //reverses the order of the entries
+  void reverse();
+
+  //the indices of the entries in lexicographic order of their keys
+  void sortedOrder(std::vector<size_type>& order) const;
+
+  //whether all projection functions combine contributions by addition,
+  //so that keys can be combined elementwise without calling them
+  static inline bool isAdditive(size_t keylen, std::vector<proj_func*>& f){
+    for (size_t i=0;i<keylen;++i){
+      if (f[i]->Type!=P_SUM && f[i]->Type!=P_SUM2) return false;
+    }
+    return true;
+  }
+  static inline void combine(int* dest, const int* x, const int* y, size_t keylen,
+			     std::vector<proj_func*>& f, bool additive){
+    if (additive){
+      for (size_t i=0;i<keylen;++i) dest[i]=x[i]+y[i];
+    }
+    else{
+      for (size_t i=0;i<keylen;++i) dest[i]=(*(f[i]))(x[i],y[i]);
+    }
+  }
+
+  //adds y to the entry with key conf, for operator/=
+  void divAdd(const key_type& conf, V y, V th, V pivot);
+};
+
+template <class V> const double config_map<V>::THRESH = 1e-12;
+
+
+template <class V>
+inline std::ostream& operator<< (std::ostream& s, const config_map<V>& t)
+{
+  //s<<std::endl;
+  for (typename config_map<V>::const_iterator p=t.begin();p!=t.end();++p){
+    s<<"[ ";
+    copy(p->first.begin(),p->first.end(),std::ostream_iterator<int>(s, " "));
+    s<< "] "<<p->second<<std::endl;
+  }
+  return s;
+}
+
+}  // end namespace Gambit::agg
+
+}  // end namespace Gambit
+
+#include "config_map.imp"
+
+#endif   // GAMBIT_AGG_CONFIGMAP_H
@@ -821,7 +821,12 @@ inline GamePlayer GameStrategyRep::GetPlayer() const { return m_player; }
 
 inline Game GamePlayerRep::GetGame() const { return m_game; }
 inline int GamePlayerRep::NumStrategies() const 
-{ m_game->BuildComputedValues(); return m_strategies.Length(); }
+{
+  if (m_game->IsTree() && !IsChance() && !m_game->HasComputedValues()) {
+    return m_game->NumStrategies()[m_number];
+  }
+  m_game->BuildComputedValues(); return m_strategies.Length();
+}
 inline GameStrategy GamePlayerRep::GetStrategy(int st) const 
 { m_game->BuildComputedValues(); return m_strategies[st]; }
 inline const GameStrategyArray &GamePlayerRep::Strategies() const
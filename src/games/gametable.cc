@@ -121,6 +121,156 @@ PureStrategyProfile GameTableRep::NewPureStrategyProfile() const
 
 
 
+//========================================================================
+//                      class SymmetricPayoffTable
+//========================================================================
+
+SymmetricPayoffTable::SymmetricPayoffTable(int p_numPlayers, int p_numStrategies)
+  : m_numPlayers(p_numPlayers), m_numStrategies(p_numStrategies),
+    m_choose(p_numStrategies + 1, std::vector<int>(p_numPlayers, 1))
+{
+  for (int t = 2; t <= m_numStrategies; t++) {
+    for (int n = 1; n < m_numPlayers; n++) {
+      m_choose[t][n] = m_choose[t - 1][n] + m_choose[t][n - 1];
+    }
+  }
+  m_numProfiles = m_choose[m_numStrategies][m_numPlayers - 1];
+  m_payoffs.assign(m_numStrategies * m_numProfiles, 0.0);
+
+  Enumerate(m_numPlayers - 1, m_counts, m_coeffs);
+  if (m_numPlayers >= 2) {
+    Enumerate(m_numPlayers - 2, m_subCounts, m_subCoeffs);
+    m_extend.resize(m_subCoeffs.size() * m_numStrategies);
+    std::vector<int> counts(m_numStrategies);
+    for (size_t i = 0; i < m_subCoeffs.size(); i++) {
+      std::copy(m_subCounts.begin() + i * m_numStrategies,
+		m_subCounts.begin() + (i + 1) * m_numStrategies, counts.begin());
+      for (int st = 0; st < m_numStrategies; st++) {
+	counts[st]++;
+	m_extend[i * m_numStrategies + st] = Index(counts.data(), m_numPlayers - 1);
+	counts[st]--;
+      }
+    }
+  }
+}
+
+//
+// Multisets of size n are ordered by decreasing lexicographic order of
+// their counts.  Those before a given one are, for each strategy j, those
+// which agree on the strategies before j and have more of j; this
+// gives the sum below.
+//
+int SymmetricPayoffTable::Index(const int *p_counts, int p_size) const
+{
+  int index = 0;
+  for (int j = 0, rest = p_size; j < m_numStrategies - 1; rest -= p_counts[j++]) {
+    if (rest > p_counts[j]) {
+      index += m_choose[m_numStrategies - j][rest - p_counts[j] - 1];
+    }
+  }
+  return index;
+}
+
+int SymmetricPayoffTable::GetIndex(const Array<int> &p_counts) const
+{
+  std::vector<int> counts(m_numStrategies);
+  for (int st = 1; st <= m_numStrategies; st++) {
+    counts[st - 1] = p_counts[st];
+  }
+  return Index(counts.data(), m_numPlayers - 1);
+}
+
+void SymmetricPayoffTable::Enumerate(int p_size, std::vector<int> &p_counts,
+				     std::vector<double> &p_coeffs) const
+{
+  // binomial coefficients, for the multinomial coefficients
+  std::vector<std::vector<double> > binom(p_size + 1);
+  for (int n = 0; n <= p_size; n++) {
+    binom[n].assign(n + 1, 1.0);
+    for (int r = 1; r < n; r++) {
+      binom[n][r] = binom[n - 1][r - 1] + binom[n - 1][r];
+    }
+  }
+
+  std::vector<int> counts(m_numStrategies, 0);
+  counts[0] = p_size;
+  p_counts.clear();
+  p_coeffs.clear();
+  while (true) {
+    double coeff = 1.0;
+    for (int j = 0, rest = p_size; j < m_numStrategies; rest -= counts[j++]) {
+      coeff *= binom[rest][counts[j]];
+    }
+    p_counts.insert(p_counts.end(), counts.begin(), counts.end());
+    p_coeffs.push_back(coeff);
+
+    // The next multiset takes one from the last strategy j before the
+    // final one with a nonzero count, and gives it, together with the
+    // count of the final strategy, to strategy j+1
+    int j = m_numStrategies - 2;
+    while (j >= 0 && counts[j] == 0) j--;
+    if (j < 0) break;
+    int rest = counts[m_numStrategies - 1];
+    counts[m_numStrategies - 1] = 0;
+    counts[j]--;
+    counts[j + 1] = rest + 1;
+  }
+}
+
+void SymmetricPayoffTable::Powers(const Vector<double> &p_mix,
+				  std::vector<double> &p_powers) const
+{
+  p_powers.resize(m_numStrategies * m_numPlayers);
+  for (int st = 0; st < m_numStrategies; st++) {
+    p_powers[st * m_numPlayers] = 1.0;
+    for (int n = 1; n < m_numPlayers; n++) {
+      p_powers[st * m_numPlayers + n] = p_powers[st * m_numPlayers + n - 1] * p_mix[st + 1];
+    }
+  }
+}
+
+void SymmetricPayoffTable::GetPayoffs(const Vector<double> &p_mix,
+				      Vector<double> &p_values) const
+{
+  std::vector<double> powers;
+  Powers(p_mix, powers);
+  p_values = 0.0;
+  for (int i = 0; i < m_numProfiles; i++) {
+    double prob = m_coeffs[i];
+    const int *counts = &m_counts[i * m_numStrategies];
+    for (int st = 0; st < m_numStrategies; st++) {
+      prob *= powers[st * m_numPlayers + counts[st]];
+    }
+    if (prob == 0.0) continue;
+    for (int st = 1; st <= m_numStrategies; st++) {
+      p_values[st] += prob * GetPayoff(st, i);
+    }
+  }
+}
+
+void SymmetricPayoffTable::GetPayoffDerivs(const Vector<double> &p_mix,
+					   Matrix<double> &p_derivs) const
+{
+  p_derivs = 0.0;
+  if (m_numPlayers < 2) return;
+  std::vector<double> powers;
+  Powers(p_mix, powers);
+  for (size_t i = 0; i < m_subCoeffs.size(); i++) {
+    double prob = m_subCoeffs[i];
+    const int *counts = &m_subCounts[i * m_numStrategies];
+    for (int st = 0; st < m_numStrategies; st++) {
+      prob *= powers[st * m_numPlayers + counts[st]];
+    }
+    if (prob == 0.0) continue;
+    for (int l = 1; l <= m_numStrategies; l++) {
+      int index = m_extend[i * m_numStrategies + l - 1];
+      for (int st = 1; st <= m_numStrategies; st++) {
+	p_derivs(st, l) += prob * GetPayoff(st, index);
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------
 //                     GameTableRep: Lifecycle
 //------------------------------------------------------------------------
@@ -200,6 +350,81 @@ bool GameTableRep::IsConstSum() const
   return true;
 }
 
+bool GameTableRep::IsSymmetric() const
+{
+  if (m_players.Length() == 0) {
+    return false;
+  }
+  for (int pl = 2; pl <= m_players.Length(); pl++) {
+    if (m_players[pl]->NumStrategies() != m_players[1]->NumStrategies()) {
+      return false;
+    }
+  }
+  SymmetricPayoffTable table(m_players.Length(), m_players[1]->NumStrategies());
+  return BuildSymmetricPayoffs(table);
+}
+
+SymmetricPayoffTable GameTableRep::GetSymmetricPayoffs() const
+{
+  if (!IsSymmetric()) {
+    throw UndefinedException("The game is not symmetric.");
+  }
+  SymmetricPayoffTable table(m_players.Length(), m_players[1]->NumStrategies());
+  BuildSymmetricPayoffs(table);
+  return table;
+}
+
+/// Fills in the payoffs of p_table from the contingencies of the game,
+/// returning false if two contingencies which are the same up to a
+/// permutation of the players have different payoffs.
+bool GameTableRep::BuildSymmetricPayoffs(SymmetricPayoffTable &p_table) const
+{
+  int numPlayers = m_players.Length(), numStrats = p_table.NumStrategies();
+  int numProfiles = p_table.NumProfiles();
+  std::vector<Rational> payoffs(numStrats * numProfiles);
+  std::vector<bool> known(payoffs.size(), false);
+  Array<int> profile(numPlayers), counts(numStrats);
+  for (int pl = 1; pl <= numPlayers; profile[pl++] = 1);
+  for (int st = 1; st <= numStrats; counts[st++] = 0);
+  counts[1] = numPlayers;
+
+  // Contingencies are numbered with the first player's strategy varying
+  // fastest, so they are visited in order by incrementing the profile
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      int st = profile[pl];
+      counts[st]--;
+      int entry = (st - 1) * numProfiles + p_table.GetIndex(counts);
+      counts[st]++;
+      Rational payoff = (outcome) ? outcome->GetPayoff<Rational>(pl) : Rational(0);
+      if (!known[entry]) {
+	payoffs[entry] = payoff;
+	known[entry] = true;
+      }
+      else if (payoffs[entry] != payoff) {
+	return false;
+      }
+    }
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      counts[profile[pl]]--;
+      if (profile[pl] < numStrats) {
+	counts[++profile[pl]]++;
+	break;
+      }
+      profile[pl] = 1;
+      counts[1]++;
+    }
+  }
+
+  for (int st = 1; st <= numStrats; st++) {
+    for (int i = 0; i < numProfiles; i++) {
+      p_table.SetPayoff(st, i, (double) payoffs[(st - 1) * numProfiles + i]);
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
@@ -24,9 +24,71 @@
 #define GAMETABLE_H
 
 #include "gameexpl.h"
+#include "core/matrix.h"
 
 namespace Gambit {
 
+/// The payoff function of a symmetric strategic game, in which each player's
+/// payoff depends only on their own strategy and on how many of the other
+/// players play each strategy.  This is stored for each of the
+/// C(N+k-2, k-1) multisets of the others' strategies, rather than for
+/// each of the k^N contingencies.
+class SymmetricPayoffTable {
+public:
+  /// @name Lifecycle
+  //@{
+  /// Construct a table of zero payoffs for the given dimension
+  SymmetricPayoffTable(int p_numPlayers, int p_numStrategies);
+  //@}
+
+  /// @name General data access
+  //@{
+  int NumPlayers() const { return m_numPlayers; }
+  int NumStrategies() const { return m_numStrategies; }
+  /// The number of multisets of the other players' strategies
+  int NumProfiles() const { return m_numProfiles; }
+  /// The index of the multiset with p_counts[st] players playing st
+  int GetIndex(const Array<int> &p_counts) const;
+
+  double GetPayoff(int p_strategy, int p_index) const
+  { return m_payoffs[(p_strategy - 1) * m_numProfiles + p_index]; }
+  void SetPayoff(int p_strategy, int p_index, double p_value)
+  { m_payoffs[(p_strategy - 1) * m_numProfiles + p_index] = p_value; }
+  //@}
+
+  /// @name Computing expected payoffs
+  //@{
+  /// The expected payoff of each strategy when all other players play
+  /// the mixed strategy p_mix
+  void GetPayoffs(const Vector<double> &p_mix, Vector<double> &p_values) const;
+  /// Entry (j, l) is the expected payoff of strategy j when one other
+  /// player plays l and the rest play p_mix.  The derivative of the
+  /// payoff of j with respect to the probability of l in the common
+  /// strategy is (N-1) times this.
+  void GetPayoffDerivs(const Vector<double> &p_mix, Matrix<double> &p_derivs) const;
+  //@}
+
+private:
+  int m_numPlayers, m_numStrategies, m_numProfiles;
+  /// Entry [t][n] is the number of multisets of size n from t strategies,
+  /// C(n+t-1, t-1)
+  std::vector<std::vector<int> > m_choose;
+  /// The payoffs of each strategy against each multiset
+  std::vector<double> m_payoffs;
+  /// The counts of each multiset of N-1 and of N-2 strategies, and the
+  /// multinomial coefficient giving the number of ways each arises
+  std::vector<int> m_counts, m_subCounts;
+  std::vector<double> m_coeffs, m_subCoeffs;
+  /// The index of each multiset of N-2 strategies with one more of each
+  /// strategy added
+  std::vector<int> m_extend;
+
+  int Index(const int *p_counts, int p_size) const;
+  void Enumerate(int p_size, std::vector<int> &p_counts,
+		 std::vector<double> &p_coeffs) const;
+  void Powers(const Vector<double> &p_mix, std::vector<double> &p_powers) const;
+};
+
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
@@ -42,6 +104,7 @@ private:
   //@{
   void IndexStrategies();
   void RebuildTable();
+  bool BuildSymmetricPayoffs(SymmetricPayoffTable &) const;
   //@}
 
 public:
@@ -57,6 +120,14 @@ public:
   //@{
   bool IsTree() const override { return false; }
   bool IsConstSum() const override;
+  /// Returns true if all players have the same number of strategies, and
+  /// each player's payoff is the same function of their own strategy and
+  /// the multiset of the others' strategies
+  bool IsSymmetric() const;
+  /// Returns the payoff function of a symmetric game over multisets of
+  /// the other players' strategies.  Throws UndefinedException if the
+  /// game is not symmetric.
+  SymmetricPayoffTable GetSymmetricPayoffs() const;
   bool IsPerfectRecall(GameInfoset &, GameInfoset &) const override
   { return true; }
   //@}
@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <map>
+#include <limits>
 
 #include "gambit.h"
 #include "gametree.h"
@@ -550,7 +552,9 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep()
-  : m_computedValues(false), m_doCanon(true)
+  : m_computedValues(false), m_doCanon(true),
+    m_checkedRecall(false), m_perfectRecall(true),
+    m_recallInfoset1(nullptr), m_recallInfoset2(nullptr)
 {
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, nullptr);
@@ -619,56 +623,230 @@ bool GameTreeRep::IsConstSum() const
   }
 }
 
+//
+// A game has perfect recall if every member of an information set is
+// reached by the same sequence of the player's own actions.  By induction
+// it is enough that all members agree on the last action the player took
+// on the path to them; this also rules out an information set preceding
+// itself.  One depth-first pass therefore suffices, tracking each
+// player's last action along the current path and the last action
+// recorded for each information set visited so far.
+//
+bool GameTreeRep::CheckPerfectRecall(GameTreeNodeRep *p_node,
+				     Array<GameTreeActionRep *> &p_lastAction,
+				     std::unordered_map<GameTreeInfosetRep *,
+				     GameTreeActionRep *> &p_seen) const
+{
+  GameTreeInfosetRep *infoset = p_node->infoset;
+  if (!infoset) return true;
+
+  if (infoset->m_player->IsChance()) {
+    for (int i = 1; i <= p_node->children.Length(); i++) {
+      if (!CheckPerfectRecall(p_node->children[i], p_lastAction, p_seen)) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  int pl = infoset->m_player->GetNumber();
+  GameTreeActionRep *last = p_lastAction[pl];
+  auto entry = p_seen.insert(std::make_pair(infoset, last));
+  if (!entry.second && entry.first->second != last) {
+    GameTreeActionRep *witness = (last) ? last : entry.first->second;
+    m_recallInfoset1 = witness->m_infoset;
+    m_recallInfoset2 = infoset;
+    return false;
+  }
+
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    p_lastAction[pl] = infoset->m_actions[i];
+    if (!CheckPerfectRecall(p_node->children[i], p_lastAction, p_seen)) {
+      return false;
+    }
+  }
+  p_lastAction[pl] = last;
+  return true;
+}
+
 bool GameTreeRep::IsPerfectRecall(GameInfoset &s1, GameInfoset &s2) const
 {
-  for (int pl = 1; pl <= m_players.Length(); pl++)   {
-    GamePlayerRep *player = m_players[pl];
-    
-    for (int i = 1; i <= player->NumInfosets(); i++)  {
-      GameTreeInfosetRep *iset1 = player->m_infosets[i];
-      for (int j = 1; j <= player->NumInfosets(); j++)   {
-	GameTreeInfosetRep *iset2 = player->m_infosets[j];
-
-	bool precedes = false;
-	int action = 0;
-	
-	for (int m = 1; m <= iset2->NumMembers(); m++)  {
-	  int n;
-	  for (n = 1; n <= iset1->NumMembers(); n++)  {
-	    if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)) &&
-	        iset1->GetMember(n) != iset2->GetMember(m))  {
-	      precedes = true;
-	      for (int act = 1; act <= iset1->NumActions(); act++)  {
-		if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)->GetChild(act))) {
-		  if (action != 0 && action != act)  {
-		    s1 = iset1;
-		    s2 = iset2;
-		    return false;
-		  }
-		  action = act;
-		}
-	      }
-	      break;
-	    }
-	  }
-	  
-	  if (i == j && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
+  if (!m_checkedRecall) {
+    Array<GameTreeActionRep *> lastAction(m_players.Length());
+    for (int pl = 1; pl <= lastAction.Length(); lastAction[pl++] = nullptr);
+    std::unordered_map<GameTreeInfosetRep *, GameTreeActionRep *> seen;
+    m_recallInfoset1 = m_recallInfoset2 = nullptr;
+    m_perfectRecall = CheckPerfectRecall(m_root, lastAction, seen);
+    m_checkedRecall = true;
+  }
 
-	  if (n > iset1->NumMembers() && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
+  if (!m_perfectRecall) {
+    s1 = m_recallInfoset1;
+    s2 = m_recallInfoset2;
+  }
+  return m_perfectRecall;
+}
+
+
+//------------------------------------------------------------------------
+//               GameTreeRep: Implicit reduced strategic form
+//------------------------------------------------------------------------
+
+//
+// Records, for each personal information set, the player's last own
+// action preceding it (which by perfect recall is the same at every
+// member), and the order in which information sets are first reached.
+//
+void GameTreeRep::BuildReducedForms(GameTreeNodeRep *p_node,
+				    Array<GameTreeActionRep *> &p_lastAction,
+				    int &p_visit) const
+{
+  GameTreeInfosetRep *infoset = p_node->infoset;
+  if (!infoset) return;
+
+  int pl = infoset->m_player->GetNumber();
+  GameTreeActionRep *last = (pl) ? p_lastAction[pl] : nullptr;
+  if (pl) {
+    ReducedForm &form = m_reducedForms[pl];
+    if (form.m_visit[infoset->m_number] == 0) {
+      form.m_visit[infoset->m_number] = ++p_visit;
+      form.m_children[infoset->m_number] = Array<Array<int> >(infoset->m_actions.Length());
+      if (last) {
+	form.m_children[last->m_infoset->m_number][last->m_number].Append(infoset->m_number);
+      }
+      else {
+	form.m_roots.Append(infoset->m_number);
+      }
+    }
+  }
+
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    if (pl) p_lastAction[pl] = infoset->m_actions[i];
+    BuildReducedForms(p_node->children[i], p_lastAction, p_visit);
+  }
+  if (pl) p_lastAction[pl] = last;
+}
+
+Integer GameTreeRep::CountReducedPlans(ReducedForm &p_form, int p_infoset) const
+{
+  Integer count(0);
+  const Array<Array<int> > &children = p_form.m_children[p_infoset];
+  for (int act = 1; act <= children.Length(); act++) {
+    Integer plans(1);
+    for (int i = 1; i <= children[act].Length(); i++) {
+      plans *= CountReducedPlans(p_form, children[act][i]);
+    }
+    count += plans;
+  }
+  p_form.m_counts[p_infoset] = count;
+  return count;
+}
+
+const GameTreeRep::ReducedForm &
+GameTreeRep::GetReducedForm(const GamePlayer &p_player) const
+{
+  if (p_player->GetGame() != this || p_player->IsChance()) {
+    throw MismatchException();
+  }
+  if (!IsPerfectRecall()) {
+    throw UndefinedException("Reduced strategies can only be indexed in games with perfect recall");
+  }
+
+  if (m_reducedForms.Length() != m_players.Length()) {
+    m_reducedForms = Array<ReducedForm>(m_players.Length());
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      ReducedForm &form = m_reducedForms[pl];
+      int ninfosets = m_players[pl]->m_infosets.Length();
+      form.m_children = Array<Array<Array<int> > >(ninfosets);
+      form.m_visit = Array<int>(ninfosets);
+      for (int iset = 1; iset <= ninfosets; form.m_visit[iset++] = 0);
+      form.m_counts = Array<Integer>(ninfosets);
+    }
+
+    Array<GameTreeActionRep *> lastAction(m_players.Length());
+    for (int pl = 1; pl <= lastAction.Length(); lastAction[pl++] = nullptr);
+    int visit = 0;
+    BuildReducedForms(m_root, lastAction, visit);
+
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      ReducedForm &form = m_reducedForms[pl];
+      form.m_total = 1;
+      for (int i = 1; i <= form.m_roots.Length(); i++) {
+	form.m_total *= CountReducedPlans(form, form.m_roots[i]);
+      }
+    }
+  }
+  return m_reducedForms[p_player->GetNumber()];
+}
+
+Integer GameTreeRep::NumReducedStrategies(const GamePlayer &p_player) const
+{
+  return GetReducedForm(p_player).m_total;
+}
+
+//
+// Reduced strategies are ordered lexicographically by the actions chosen
+// at information sets, taken in the order the tree reaches them.  At each
+// step the pending information sets are those reached by the choices made
+// so far; choosing an action at the first of them leaves a number of
+// completions equal to the product of the plan counts of what is then
+// pending, which is used to peel the index off one digit at a time.
+//
+Array<int> GameTreeRep::GetReducedStrategy(const GamePlayer &p_player,
+					   const Integer &p_index) const
+{
+  const ReducedForm &form = GetReducedForm(p_player);
+  if (p_index < 1 || p_index > form.m_total) {
+    throw IndexException();
+  }
+
+  Array<int> behav(p_player->NumInfosets());
+  for (int iset = 1; iset <= behav.Length(); behav[iset++] = 0);
+
+  std::map<int, int> pending;
+  for (int i = 1; i <= form.m_roots.Length(); i++) {
+    pending[form.m_visit[form.m_roots[i]]] = form.m_roots[i];
+  }
+
+  Integer rank = p_index - 1, rest = form.m_total;
+  while (!pending.empty()) {
+    int iset = pending.begin()->second;
+    pending.erase(pending.begin());
+    rest /= form.m_counts[iset];
+    const Array<Array<int> > &children = form.m_children[iset];
+    for (int act = 1; act <= children.Length(); act++) {
+      Integer completions = rest;
+      for (int i = 1; i <= children[act].Length(); i++) {
+	completions *= form.m_counts[children[act][i]];
+      }
+      if (rank < completions) {
+	behav[iset] = act;
+	rest = completions;
+	for (int i = 1; i <= children[act].Length(); i++) {
+	  pending[form.m_visit[children[act][i]]] = children[act][i];
 	}
+	break;
       }
+      rank -= completions;
     }
   }
+  return behav;
+}
 
-  return true;
+Rational GameTreeRep::GetReducedPayoff(const Array<Integer> &p_indices,
+				       int pl) const
+{
+  PureBehaviorProfile behav(const_cast<GameTreeRep *>(this));
+  for (int i = 1; i <= m_players.Length(); i++) {
+    GamePlayerRep *player = m_players[i];
+    Array<int> strategy = GetReducedStrategy(player, p_indices[i]);
+    for (int iset = 1; iset <= strategy.Length(); iset++) {
+      if (strategy[iset]) {
+	behav.SetAction(player->m_infosets[iset]->m_actions[strategy[iset]]);
+      }
+    }
+  }
+  return behav.GetPayoff<Rational>(pl);
 }
 
 
@@ -742,6 +920,8 @@ void GameTreeRep::ClearComputedValues() const
   }
 
   m_computedValues = false;
+  m_checkedRecall = false;
+  m_reducedForms = Array<ReducedForm>();
 }
 
 void GameTreeRep::BuildComputedValues()
@@ -879,11 +1059,64 @@ void GameTreeRep::WriteEfgFile(std::ostream &p_file, const GameNode &p_root) con
 		       dynamic_cast<GameTreeNodeRep *>(p_root.operator->()));
 }
 
+//
+// With perfect recall, the strategic form is written from the implicit
+// reduced form, without building the strategies.  Labels and the order
+// of profiles are the same as those of the built strategies.
+//
 void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
 { 
-  // FIXME: Building computed values is logically const.
-  const_cast<GameTreeRep *>(this)->BuildComputedValues();
-  GameRep::WriteNfgFile(p_file);
+  if (m_computedValues || !IsPerfectRecall()) {
+    // FIXME: Building computed values is logically const.
+    const_cast<GameTreeRep *>(this)->BuildComputedValues();
+    GameRep::WriteNfgFile(p_file);
+    return;
+  }
+
+  p_file << "NFG 1 R";
+  p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
+  for (int i = 1; i <= NumPlayers(); i++)
+    p_file << '"' << EscapeQuotes(GetPlayer(i)->GetLabel()) << "\" ";
+
+  p_file << "}\n\n{ ";
+  
+  Array<Integer> counts(NumPlayers());
+  for (int i = 1; i <= NumPlayers(); i++)   {
+    counts[i] = NumReducedStrategies(m_players[i]);
+    p_file << "{ ";
+    for (Integer j = 1; j <= counts[i]; j += 1) {
+      Array<int> behav = GetReducedStrategy(m_players[i], j);
+      std::string label;
+      for (int iset = 1; iset <= behav.Length(); iset++) {
+	label += (behav[iset] > 0) ? lexical_cast<std::string>(behav[iset]) : "*";
+      }
+      p_file << '"' << EscapeQuotes((behav.Length() > 0) ? label : "*") << "\" ";
+    }
+    p_file << "}\n";
+  }
+  p_file << "}\n";
+  p_file << "\"" << EscapeQuotes(GetComment()) << "\"\n\n";
+
+  // Profiles in the order of StrategyProfileIterator, with the first
+  // player's strategy changing fastest
+  Array<Integer> profile(NumPlayers());
+  for (int i = 1; i <= NumPlayers(); profile[i++] = 1);
+  while (true) {
+    for (int pl = 1; pl <= NumPlayers(); pl++) {
+      p_file << GetReducedPayoff(profile, pl) << " ";
+    }
+    p_file << "\n";
+    int pl = 1;
+    for (; pl <= NumPlayers(); pl++) {
+      if (profile[pl] < counts[pl]) {
+	profile[pl] += 1;
+	break;
+      }
+      profile[pl] = 1;
+    }
+    if (pl > NumPlayers())  break;
+  }
+  p_file << '\n';
 }
 
 //------------------------------------------------------------------------
@@ -934,6 +1167,39 @@ int GameTreeRep::BehavProfileLength() const
   return sum;
 }
 
+//
+// Until the reduced strategies are built, their number is computed from
+// the implicit reduced form, so that querying the size of the strategic
+// form does not require building it.
+//
+Array<int> GameTreeRep::NumStrategies() const
+{
+  if (m_computedValues || !IsPerfectRecall()) {
+    return GameExplicitRep::NumStrategies();
+  }
+  Array<int> dim(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    Integer count = NumReducedStrategies(m_players[pl]);
+    if (count > std::numeric_limits<int>::max()) {
+      // Building the strategies to count them would not fit in memory
+      throw UndefinedException("The reduced strategic form of the game is too large to represent");
+    }
+    dim[pl] = count.as_long();
+  }
+  return dim;
+}
+
+int GameTreeRep::MixedProfileLength() const
+{
+  Array<int> dim = NumStrategies();
+  long strats = 0;
+  for (int pl = 1; pl <= dim.Length(); strats += dim[pl++]);
+  if (strats > std::numeric_limits<int>::max()) {
+    throw UndefinedException("The reduced strategic form of the game is too large to represent");
+  }
+  return strats;
+}
+
 //------------------------------------------------------------------------
 //                        GameTreeRep: Players
 //------------------------------------------------------------------------
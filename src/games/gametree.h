@@ -23,6 +23,8 @@
 #ifndef GAMETREE_H
 #define GAMETREE_H
 
+#include <unordered_map>
+
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -204,10 +206,40 @@ protected:
   mutable bool m_computedValues, m_doCanon;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  /// Cached result of the perfect recall check, with the offending
+  /// pair of information sets when recall fails
+  mutable bool m_checkedRecall, m_perfectRecall;
+  mutable GameTreeInfosetRep *m_recallInfoset1, *m_recallInfoset2;
+
+  /// Implicit reduced strategy space of a player in a game with perfect
+  /// recall.  The player's information sets form a forest, in which the
+  /// children of an action are the information sets at which it is the
+  /// player's last own action; a reduced strategy picks one action at
+  /// each information set reached along its own choices.
+  struct ReducedForm {
+    /// Information sets not preceded by any of the player's own
+    Array<int> m_roots;
+    /// Children of each action, indexed by information set and action
+    Array<Array<Array<int> > > m_children;
+    /// Position of each information set in depth-first order of the tree
+    Array<int> m_visit;
+    /// Number of reduced plans below each information set
+    Array<Integer> m_counts;
+    /// Number of reduced strategies of the player
+    Integer m_total;
+  };
+  mutable Array<ReducedForm> m_reducedForms;
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  bool CheckPerfectRecall(GameTreeNodeRep *, Array<GameTreeActionRep *> &,
+			  std::unordered_map<GameTreeInfosetRep *,
+			  GameTreeActionRep *> &) const;
+  void BuildReducedForms(GameTreeNodeRep *, Array<GameTreeActionRep *> &,
+			 int &) const;
+  Integer CountReducedPlans(ReducedForm &, int) const;
+  const ReducedForm &GetReducedForm(const GamePlayer &) const;
   //@}
 
   /// @name Managing the representation
@@ -272,6 +304,28 @@ public:
   PVector<int> NumMembers() const override;
   /// Returns the total number of actions in the game
   int BehavProfileLength() const override;
+  /// The number of strategies for each player
+  Array<int> NumStrategies() const override;
+  /// Returns the total number of strategies in the game
+  int MixedProfileLength() const override;
+  //@}
+
+  /// @name Implicit reduced strategic form
+  ///
+  /// These members describe the reduced strategies of a game with perfect
+  /// recall without building them.  Strategies are indexed from 1, in the
+  /// same order as GamePlayerRep::GetStrategy() uses once built.
+  //@{
+  /// Returns the number of reduced strategies of the player
+  Integer NumReducedStrategies(const GamePlayer &) const;
+  /// Returns the action chosen by the p_index'th reduced strategy of
+  /// the player at each of the player's information sets, or zero where
+  /// the information set cannot be reached under the strategy
+  Array<int> GetReducedStrategy(const GamePlayer &,
+				const Integer &p_index) const;
+  /// Returns the payoff to player pl when each player plays the reduced
+  /// strategy with the given index, evaluated on the tree
+  Rational GetReducedPayoff(const Array<Integer> &p_indices, int pl) const;
   //@}
 
   /// @name Information sets
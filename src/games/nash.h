@@ -93,6 +93,25 @@ private:
   int m_numDecimals;
 };
 
+//
+// Renders profiles on a restriction of a game, as created by
+// StrategySupportProfile::Restrict(), by passing the corresponding
+// profile on the unrestricted game to another renderer.
+//
+template <class T>
+class RestrictedStrategyRenderer : public MixedStrategyRenderer<T> {
+public:
+  RestrictedStrategyRenderer(shared_ptr<StrategyProfileRenderer<T> > p_renderer)
+    : m_renderer(p_renderer) { }
+  ~RestrictedStrategyRenderer() override = default;
+  void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const override
+  { m_renderer->Render(p_profile.Unrestrict(), p_label); }
+
+private:
+  shared_ptr<StrategyProfileRenderer<T> > m_renderer;
+};
+
 //
 // Encapsulates the rendering of a behavior profile to various text formats.
 //
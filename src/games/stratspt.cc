@@ -20,6 +20,11 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
 #include "gambit.h"
 #include "gametable.h"
 
@@ -221,13 +226,188 @@ bool StrategySupportProfile::RemoveStrategy(const GameStrategy &p_strategy)
 //                 Identification of dominated strategies
 //---------------------------------------------------------------------------
 
+///
+/// The payoffs to a set of strategies of one player, against each
+/// contingency of the other players' strategies in a support.
+///
+/// Payoffs are held as doubles, stored contingency by contingency so
+/// that the payoffs of all strategies against one contingency are
+/// adjacent, together with pointers to their exact values.  The exact
+/// values are consulted only when two doubles are too close to be told
+/// apart reliably.  For table games, both are read directly from the
+/// outcome of each cell, using the strategy offsets into the table.
+///
+class StrategySupportProfile::PayoffSlice {
+public:
+  PayoffSlice(const StrategySupportProfile &p_support, int p_player,
+	      const Array<GameStrategy> &p_strategies);
+  /// Slices may be moved but not copied, as a copy would point into
+  /// the payoffs owned by the original
+  PayoffSlice(const PayoffSlice &) = delete;
+  PayoffSlice(PayoffSlice &&) = default;
+
+  int NumStrategies() const { return m_rows; }
+
+  /// Compute in one pass over the contingencies which strategies in
+  /// the slice dominate which others.  On return, entry i * n + j is
+  /// true exactly when strategy i + 1 dominates strategy j + 1.
+  std::vector<char> Dominance(bool p_strict) const;
+
+private:
+  int m_rows;
+  long m_cols;
+  std::vector<double> m_double;
+  std::vector<const Rational *> m_exact;
+  std::vector<Rational> m_values;
+
+  /// Returns the sign of the difference between the payoffs of
+  /// strategies i and j (zero-based) against contingency c
+  int Compare(int i, int j, long c) const
+  {
+    double a = m_double[c * m_rows + i], b = m_double[c * m_rows + j];
+    double tol = 1.0e-10 * std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+    if (a - b > tol)  return 1;
+    if (b - a > tol)  return -1;
+    const Rational &x = *m_exact[c * m_rows + i], &y = *m_exact[c * m_rows + j];
+    return (x < y) ? -1 : ((y < x) ? 1 : 0);
+  }
+};
+
+StrategySupportProfile::PayoffSlice::PayoffSlice(const StrategySupportProfile &p_support,
+			 int p_player,
+			 const Array<GameStrategy> &p_strategies)
+  : m_rows(p_strategies.Length()), m_cols(1)
+{
+  static const Rational zero(0);
+
+  Game game = p_support.GetGame();
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    if (pl != p_player)  m_cols *= p_support.NumStrategies(pl);
+  }
+  m_double.resize(m_rows * m_cols);
+  m_exact.resize(m_rows * m_cols);
+
+  if (!game->IsTree() && dynamic_cast<GameTableRep *>(game.operator->())) {
+    const GameTableRep &table = dynamic_cast<GameTableRep &>(*game);
+    // The table indices of each contingency of the other players,
+    // with the player's own strategy offset left out
+    std::vector<long> bases(1, 1L);
+    bases.reserve(m_cols);
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      if (pl == p_player)  continue;
+      const Array<GameStrategy> &strategies = p_support.Strategies(game->GetPlayer(pl));
+      std::vector<long> next;
+      next.reserve(bases.size() * strategies.Length());
+      for (int st = 1; st <= strategies.Length(); st++) {
+	long offset = strategies[st]->m_offset;
+	for (size_t c = 0; c < bases.size(); c++) {
+	  next.push_back(bases[c] + offset);
+	}
+      }
+      bases.swap(next);
+    }
+
+    for (long c = 0; c < m_cols; c++) {
+      for (int i = 0; i < m_rows; i++) {
+	GameOutcomeRep *outcome = table.m_results[bases[c] + p_strategies[i+1]->m_offset];
+	if (outcome) {
+	  m_double[c * m_rows + i] = outcome->GetPayoff<double>(p_player);
+	  m_exact[c * m_rows + i] = &outcome->GetPayoff<Rational>(p_player);
+	}
+	else {
+	  m_double[c * m_rows + i] = 0.0;
+	  m_exact[c * m_rows + i] = &zero;
+	}
+      }
+    }
+  }
+  else {
+    m_values.reserve(m_rows * m_cols);
+    StrategyProfileIterator iter(p_support, p_player, 1);
+    for (; !iter.AtEnd(); iter++) {
+      for (int i = 1; i <= m_rows; i++) {
+	m_values.push_back((*iter)->GetStrategyValue(p_strategies[i]));
+      }
+    }
+    for (long k = 0; k < m_rows * m_cols; k++) {
+      m_double[k] = (double) m_values[k];
+      m_exact[k] = &m_values[k];
+    }
+  }
+}
+
+std::vector<char> StrategySupportProfile::PayoffSlice::Dominance(bool p_strict) const
+{
+  // Each candidate pair (i, j) remains active for as long as i might
+  // still dominate j; for weak dominance, 'better' records whether i has
+  // already been seen to do strictly better than j somewhere.
+  struct Candidate { int i, j; bool better; };
+  std::vector<Candidate> active;
+  for (int i = 0; i < m_rows; i++) {
+    for (int j = 0; j < m_rows; j++) {
+      if (i != j)  active.push_back(Candidate{i, j, false});
+    }
+  }
+
+  for (long c = 0; c < m_cols && !active.empty(); c++) {
+    for (size_t k = 0; k < active.size(); ) {
+      int cmp = Compare(active[k].i, active[k].j, c);
+      if (cmp < 0 || (p_strict && cmp == 0)) {
+	active[k] = active.back();
+	active.pop_back();
+      }
+      else {
+	if (cmp > 0)  active[k].better = true;
+	k++;
+      }
+    }
+  }
+
+  std::vector<char> dominates(m_rows * m_rows, 0);
+  for (const auto &candidate : active) {
+    if (p_strict || candidate.better) {
+      dominates[candidate.i * m_rows + candidate.j] = 1;
+    }
+  }
+  return dominates;
+}
+
+namespace {
+
+/// Returns the strategies of the player which are candidates for
+/// dominating others, according to whether dominance is 'external'
+Array<GameStrategy> DominanceCandidates(const StrategySupportProfile &p_support,
+					int p_player, bool p_external)
+{
+  if (p_external) {
+    GamePlayer player = p_support.GetGame()->GetPlayer(p_player);
+    Array<GameStrategy> set(player->NumStrategies());
+    for (int st = 1; st <= set.Length(); st++) {
+      set[st] = player->GetStrategy(st);
+    }
+    return set;
+  }
+  else {
+    return p_support.Strategies(p_support.GetGame()->GetPlayer(p_player));
+  }
+}
+
+}  // end anonymous namespace
+
+//
+// Dominates and IsDominated answer a question about a single strategy,
+// and are called for every cell when the GUI draws a table; they stream
+// over the contingencies and stop at the first one that settles the
+// answer, rather than building a PayoffSlice for all candidates.
+//
 bool StrategySupportProfile::Dominates(const GameStrategy &s,
 				const GameStrategy &t, 
 				bool p_strict) const
 {
   bool equal = true;
   
-  for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
+  for (StrategyProfileIterator iter(*this, s->GetPlayer()->GetNumber(), 1);
+       !iter.AtEnd(); iter++) {
     Rational ap = (*iter)->GetStrategyValue(s);
     Rational bp = (*iter)->GetStrategyValue(t);
     if (p_strict && ap <= bp) {
@@ -247,93 +427,40 @@ bool StrategySupportProfile::IsDominated(const GameStrategy &s,
 				  bool p_strict,
 				  bool p_external) const
 {
-  if (p_external) {
-    GamePlayer player = s->GetPlayer();
-    for (int st = 1; st <= player->NumStrategies(); st++) {
-      if (player->GetStrategy(st) != s &&
-	  Dominates(player->GetStrategy(st), s, p_strict)) {
-	return true;
-      }
-    }
-    return false;
-  }
-  else {
-    for (int i = 1; i <= NumStrategies(s->GetPlayer()->GetNumber()); i++) {
-      if (GetStrategy(s->GetPlayer()->GetNumber(), i) != s &&
-	  Dominates(GetStrategy(s->GetPlayer()->GetNumber(), i), s, 
-		    p_strict)) {
-	return true;
-      }
+  Array<GameStrategy> set = DominanceCandidates(*this, s->GetPlayer()->GetNumber(),
+						p_external);
+  for (int st = 1; st <= set.Length(); st++) {
+    if (set[st] != s && Dominates(set[st], s, p_strict)) {
+      return true;
     }
-    return false;
   }
+  return false;
 }
 
 bool StrategySupportProfile::Undominated(StrategySupportProfile &newS, int p_player,
 				  bool p_strict, bool p_external) const
 {
-  Array<GameStrategy> set((p_external) ? 
-			  m_nfg->GetPlayer(p_player)->NumStrategies() :
-			  NumStrategies(p_player));
-
-  if (p_external) {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = m_nfg->GetPlayer(p_player)->GetStrategy(st);
-    }
-  }
-  else {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = GetStrategy(p_player, st);
-    }
-  }
+  Array<GameStrategy> set = DominanceCandidates(*this, p_player, p_external);
+  PayoffSlice slice(*this, p_player, set);
+  return RemoveDominated(newS, set, slice.Dominance(p_strict));
+}
 
-  int min = 0, dis = set.Length() - 1;
-
-  while (min <= dis) {
-    int pp;
-    for (pp = 0;
-	 pp < min && !Dominates(set[pp+1], set[dis+1], p_strict);
-	 pp++);
-    if (pp < min)
-      dis--;
-    else  {
-      GameStrategy foo = set[dis+1];
-      set[dis+1] = set[min+1];
-      set[min+1] = foo;
-
-      for (int inc = min + 1; inc <= dis; )  {
-	if (Dominates(set[min+1], set[dis+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[dis+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[min+1])->GetNumber() << '\n';
-	  dis--;
-	}
-	else if (Dominates(set[dis+1], set[min+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[min+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[dis+1])->GetNumber() << '\n';
-	  foo = set[dis+1];
-	  set[dis+1] = set[min+1];
-	  set[min+1] = foo;
-	  dis--;
-	}
-	else  {
-	  foo = set[dis+1];
-	  set[dis+1] = set[inc+1];
-	  set[inc+1] = foo;
-	  inc++;
-	}
+bool StrategySupportProfile::RemoveDominated(StrategySupportProfile &newS,
+					     const Array<GameStrategy> &p_set,
+					     const std::vector<char> &p_dominates)
+{
+  // Weak and strict dominance are both transitive, so removing every
+  // strategy dominated by any other leaves exactly the undominated ones.
+  bool removed = false;
+  for (int j = 1; j <= p_set.Length(); j++) {
+    for (int i = 1; i <= p_set.Length(); i++) {
+      if (p_dominates[(i-1) * p_set.Length() + (j-1)]) {
+	removed = newS.RemoveStrategy(p_set[j]) || removed;
+	break;
       }
-      min++;
-    }
-  }
-    
-  if (min + 1 <= set.Length()) {
-    for (int i = min + 1; i <= set.Length(); i++) {
-      newS.RemoveStrategy(set[i]);
     }
-    
-    return true;
-  }
-  else {
-    return false;
   }
+  return removed;
 }
 
 StrategySupportProfile StrategySupportProfile::Undominated(bool p_strict,
@@ -361,6 +488,58 @@ StrategySupportProfile::Undominated(bool p_strict, const Array<int> &players) co
   return newS;
 }
 
+StrategySupportProfile
+StrategySupportProfile::IteratedUndominated(bool p_strict, bool p_external) const
+{
+  StrategySupportProfile support(*this);
+  int numPlayers = m_nfg->NumPlayers();
+
+  while (true) {
+    // The payoff slices are built here, as doing so uses the game
+    // objects; only the comparisons of payoffs are done in parallel.
+    std::vector<Array<GameStrategy> > sets;
+    std::vector<PayoffSlice> slices;
+    sets.reserve(numPlayers);
+    slices.reserve(numPlayers);
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      sets.push_back(DominanceCandidates(support, pl, p_external));
+      slices.push_back(PayoffSlice(support, pl, sets.back()));
+    }
+
+    std::vector<std::vector<char> > dominates(numPlayers);
+    int numThreads = std::min(numPlayers,
+			      std::max(1, (int) std::thread::hardware_concurrency()));
+    if (numThreads > 1) {
+      std::vector<std::thread> threads;
+      for (int t = 0; t < numThreads; t++) {
+	threads.push_back(std::thread([&, t]() {
+	      for (int pl = t; pl < numPlayers; pl += numThreads) {
+		dominates[pl] = slices[pl].Dominance(p_strict);
+	      }
+	    }));
+      }
+      for (auto &thread : threads) {
+	thread.join();
+      }
+    }
+    else {
+      for (int pl = 0; pl < numPlayers; pl++) {
+	dominates[pl] = slices[pl].Dominance(p_strict);
+      }
+    }
+
+    StrategySupportProfile newS(support);
+    bool removed = false;
+    for (int pl = 0; pl < numPlayers; pl++) {
+      removed = RemoveDominated(newS, sets[pl], dominates[pl]) || removed;
+    }
+    if (!removed) {
+      return support;
+    }
+    support = newS;
+  }
+}
+
 //---------------------------------------------------------------------------
 //                Identification of overwhelmed strategies
 //---------------------------------------------------------------------------
@@ -401,7 +580,7 @@ Game StrategySupportProfile::Restrict() const
     player->m_unrestricted = m_nfg->Players()[pl];
     for (int st = 1; st <= player->NumStrategies(); st++) {
       GameStrategyRep *strategy = player->m_strategies[st];
-      strategy->m_unrestricted = m_nfg->Players()[pl]->Strategies()[st];
+      strategy->m_unrestricted = m_support[pl][st];
     }
   }
   dynamic_cast<GameTableRep &>(*restricted).m_unrestricted = m_nfg;
@@ -23,6 +23,8 @@
 #ifndef LIBGAMBIT_STRATSPT_H
 #define LIBGAMBIT_STRATSPT_H
 
+#include <vector>
+
 #include "gambit.h"
 
 namespace Gambit {
@@ -55,6 +57,13 @@ protected:
   bool Undominated(StrategySupportProfile &newS, int p_player, 
 		   bool p_strict, bool p_external = false) const;
 
+  class PayoffSlice;
+  /// Removes from newS each strategy in p_set dominated by another,
+  /// given the dominance relation as computed by a payoff slice
+  static bool RemoveDominated(StrategySupportProfile &newS,
+			      const Array<GameStrategy> &p_set,
+			      const std::vector<char> &p_dominates);
+
 public:
   /// @name Lifecycle
   //@{
@@ -140,6 +149,13 @@ public:
   /// Returns a copy of the support with dominated strategies eliminated
   StrategySupportProfile Undominated(bool p_strict, bool p_external = false) const;
   StrategySupportProfile Undominated(bool strong, const Array<int> &players) const;
+  /// \brief Iteratively eliminate dominated strategies
+  ///
+  /// Returns a copy of the support from which dominated strategies
+  /// have been eliminated, for all players simultaneously, repeatedly
+  /// until no strategy of any player is dominated.
+  StrategySupportProfile IteratedUndominated(bool p_strict,
+					     bool p_external = false) const;
   //@}
 
   /// @name Identification of overwhelmed strategies
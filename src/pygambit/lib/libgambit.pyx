@@ -25,8 +25,10 @@
 import decimal
 import fractions
 import warnings
+import numpy
 from libcpp cimport bool
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 class Decimal(decimal.Decimal):
     pass
@@ -20,8 +20,10 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
 #include "gambit.h"
 #include "tools/logit/nfglogit.h"
+#include "tools/logit/efglogit.h"
 
 using namespace std;
 using namespace Gambit;
@@ -64,3 +66,124 @@ logit_principal_branch(const Game &p_game, double p_maxLambda=1000000.0)
   return alg.TraceStrategicPath(p_game, null_stream, p_maxLambda, 1.0);
 }
 
+
+//
+// The traces below run without the Python interpreter lock.  Each point
+// on the path is recorded as lambda followed by the probabilities, and is
+// passed to the observer, if one is given.  The observer acquires the lock
+// itself, and returns nonzero to stop the trace at that point.
+//
+typedef int (*LogitObserver)(void *p_data, double p_lambda,
+			     const double *p_probs, int p_length);
+
+class LogitTraceStopped : public Exception {
+public:
+  LogitTraceStopped() : Exception("Trace stopped by observer") { }
+  ~LogitTraceStopped() noexcept override = default;
+};
+
+class LogitPathRecorder : public PathTracer::CallbackFunction {
+public:
+  LogitPathRecorder(LogitObserver p_observer, void *p_data)
+    : m_observer(p_observer), m_data(p_data) { }
+  ~LogitPathRecorder() override = default;
+
+  void operator()(const Vector<double> &p_point,
+		  bool p_isTerminal) const override
+  {
+    int length = p_point.Length() - 1;
+    m_points.push_back(p_point[p_point.Length()]);
+    for (int i = 1; i <= length; i++) {
+      m_points.push_back(exp(p_point[i]));
+    }
+    if (m_observer && m_observer(m_data, p_point[p_point.Length()],
+				 &m_points[m_points.size() - length], length)) {
+      throw LogitTraceStopped();
+    }
+  }
+  const std::vector<double> &GetPoints() const { return m_points; }
+
+private:
+  LogitObserver m_observer;
+  void *m_data;
+  mutable std::vector<double> m_points;
+};
+
+std::vector<double>
+logit_trace_strategic(const Game &p_game, double p_maxLambda,
+		      LogitObserver p_observer, void *p_data)
+{
+  LogitQREMixedStrategyProfile start(p_game);
+  StrategicQREPathTracer alg;
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  LogitPathRecorder recorder(p_observer, p_data);
+  try {
+    alg.TraceStrategicPath(start, null_stream, p_maxLambda, 1.0, recorder);
+  }
+  catch (LogitTraceStopped &) { }
+  return recorder.GetPoints();
+}
+
+std::vector<double>
+logit_solve_strategic(const Game &p_game, double p_lambda,
+		      LogitObserver p_observer, void *p_data)
+{
+  LogitQREMixedStrategyProfile start(p_game);
+  StrategicQREPathTracer alg;
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  LogitPathRecorder recorder(p_observer, p_data);
+  try {
+    alg.SolveAtLambda(start, null_stream, p_lambda, 1.0, recorder);
+  }
+  catch (LogitTraceStopped &) { }
+  return recorder.GetPoints();
+}
+
+// Returns the maximizer of the likelihood, as lambda followed by the
+// probabilities, followed by the log-likelihood
+std::vector<double>
+logit_estimate_strategic(MixedStrategyProfile<double> *p_frequencies,
+			 double p_maxLambda,
+			 LogitObserver p_observer, void *p_data)
+{
+  LogitQREMixedStrategyProfile start(p_frequencies->GetGame());
+  StrategicQREEstimator alg;
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  LogitPathRecorder recorder(p_observer, p_data);
+  std::vector<double> result;
+  try {
+    LogitQREMixedStrategyProfile qre = alg.Estimate(start, *p_frequencies,
+						    null_stream,
+						    p_maxLambda, 1.0,
+						    recorder);
+    result.push_back(qre.GetLambda());
+    double logL = 0.0;
+    for (int i = 1; i <= qre.MixedProfileLength(); i++) {
+      result.push_back(qre[i]);
+      logL += (*p_frequencies)[i] * log(qre[i]);
+    }
+    result.push_back(logL);
+  }
+  catch (LogitTraceStopped &) { }
+  return result;
+}
+
+std::vector<double>
+logit_trace_agent(const Game &p_game, double p_maxLambda, double p_targetLambda,
+		  LogitObserver p_observer, void *p_data)
+{
+  LogitQREMixedBehaviorProfile start(p_game);
+  AgentQREPathTracer alg;
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  LogitPathRecorder recorder(p_observer, p_data);
+  try {
+    alg.TraceAgentPath(start, null_stream, p_maxLambda, 1.0, p_targetLambda,
+		       recorder);
+  }
+  catch (LogitTraceStopped &) { }
+  return recorder.GetPoints();
+}
@@ -408,6 +408,15 @@ cdef extern from "nash.h":
     c_LogitQREMixedStrategyProfile *_logit_estimate "logit_estimate"(c_MixedStrategyProfileDouble *)
     c_LogitQREMixedStrategyProfile *_logit_atlambda "logit_atlambda"(c_Game, double)
     c_List[c_LogitQREMixedStrategyProfile] _logit_principal_branch "logit_principal_branch"(c_Game, double)
+    ctypedef int (*c_LogitObserver "LogitObserver")(void *, double, const double *, int)
+    vector[double] _logit_trace_strategic "logit_trace_strategic"(c_Game, double,
+                                                                  c_LogitObserver, void *) except + nogil
+    vector[double] _logit_solve_strategic "logit_solve_strategic"(c_Game, double,
+                                                                  c_LogitObserver, void *) except + nogil
+    vector[double] _logit_estimate_strategic "logit_estimate_strategic"(c_MixedStrategyProfileDouble *, double,
+                                                                        c_LogitObserver, void *) except + nogil
+    vector[double] _logit_trace_agent "logit_trace_agent"(c_Game, double, double,
+                                                          c_LogitObserver, void *) except + nogil
     
 cdef class LogitQREMixedStrategyProfile(object):
     cdef c_LogitQREMixedStrategyProfile *thisptr
@@ -470,3 +479,106 @@ def logit_principal_branch(Game p_game, double p_maxLambda=100000.0):
         p.thisptr = copyitem_list_qrem(solns, i+1)
         ret.append(p)
     return ret
+
+
+# The traces below run with the interpreter lock released.  If a callback
+# is given, it is called as callback(lam, probs) at each point on the path,
+# where probs is a numpy array of the probabilities; an exception raised by
+# the callback stops the trace and is raised again by the calling function.
+# The state passed through the C++ code is a list [callback, exception].
+cdef int _logit_observe(void *data, double lam, const double *probs, int length) noexcept with gil:
+    cdef int i
+    cdef double[::1] view
+    state = <list> data
+    try:
+        point = numpy.empty(length)
+        view = point
+        for i in range(length):
+            view[i] = probs[i]
+        state[0](lam, point)
+        return 0
+    except BaseException as exc:
+        state[1] = exc
+        return 1
+
+cdef _logit_points(vector[double] &points, int width, list state):
+    cdef size_t i
+    cdef double[::1] view
+    if state[1] is not None:
+        raise state[1]
+    result = numpy.empty(points.size())
+    view = result
+    for i in range(points.size()):
+        view[i] = points[i]
+    return result.reshape((-1, width))
+
+def logit_trace_strategic(Game p_game, double p_maxLambda=1000000.0, callback=None):
+    """Trace the principal branch of the logit QRE correspondence of the
+    strategic game, up to lambda of p_maxLambda.  Returns a pair of numpy
+    arrays: the values of lambda, and the profiles at each, one per row.
+    """
+    cdef c_Game game = p_game.game
+    cdef vector[double] points
+    cdef list state = [callback, None]
+    cdef c_LogitObserver observer = NULL
+    cdef void *data = <void *> state
+    if callback is not None:
+        observer = _logit_observe
+    with nogil:
+        points = _logit_trace_strategic(game, p_maxLambda, observer, data)
+    result = _logit_points(points, game.deref().MixedProfileLength() + 1, state)
+    return result[:, 0], result[:, 1:]
+
+def logit_solve_strategic(Game p_game, double p_lambda, callback=None):
+    """Compute the first QRE along the principal branch with the given
+    lambda parameter.  Returns lambda and the profile as a numpy array.
+    """
+    cdef c_Game game = p_game.game
+    cdef vector[double] points
+    cdef list state = [callback, None]
+    cdef c_LogitObserver observer = NULL
+    cdef void *data = <void *> state
+    if callback is not None:
+        observer = _logit_observe
+    with nogil:
+        points = _logit_solve_strategic(game, p_lambda, observer, data)
+    result = _logit_points(points, game.deref().MixedProfileLength() + 1, state)
+    return result[-1, 0], result[-1, 1:]
+
+def logit_estimate_strategic(MixedStrategyProfileDouble p_frequencies,
+                             double p_maxLambda=1000000.0, callback=None):
+    """Estimate QRE corresponding to the frequencies of play in the
+    profile using maximum likelihood along the principal branch.  Returns
+    lambda, the profile as a numpy array, and the log-likelihood.
+    """
+    cdef vector[double] points
+    cdef list state = [callback, None]
+    cdef c_LogitObserver observer = NULL
+    cdef void *data = <void *> state
+    if callback is not None:
+        observer = _logit_observe
+    with nogil:
+        points = _logit_estimate_strategic(p_frequencies.profile, p_maxLambda,
+                                           observer, data)
+    result = _logit_points(points, points.size(), state)
+    return result[0, 0], result[0, 1:-1], result[0, -1]
+
+def logit_trace_agent(Game p_game, double p_maxLambda=1000000.0, callback=None,
+                      double p_targetLambda=-1.0):
+    """Trace the principal branch of the agent logit QRE correspondence of
+    the extensive game, up to lambda of p_maxLambda, or stopping at
+    p_targetLambda if it is positive.  Returns a pair of numpy arrays: the
+    values of lambda, and the behavior profiles at each, one per row.
+    """
+    cdef c_Game game = p_game.game
+    cdef vector[double] points
+    cdef list state = [callback, None]
+    cdef c_LogitObserver observer = NULL
+    cdef void *data = <void *> state
+    if callback is not None:
+        observer = _logit_observe
+    width = len(p_game.mixed_behavior_profile()) + 1
+    with nogil:
+        points = _logit_trace_agent(game, p_maxLambda, p_targetLambda, observer, data)
+    result = _logit_points(points, width, state)
+    return result[:, 0], result[:, 1:]
@@ -391,3 +391,7 @@ def gnm_solve(game, external=False):
 logit_estimate = pygambit.lib.libgambit.logit_estimate
 logit_atlambda = pygambit.lib.libgambit.logit_atlambda
 logit_principal_branch = pygambit.lib.libgambit.logit_principal_branch
+logit_trace_strategic = pygambit.lib.libgambit.logit_trace_strategic
+logit_solve_strategic = pygambit.lib.libgambit.logit_solve_strategic
+logit_estimate_strategic = pygambit.lib.libgambit.logit_estimate_strategic
+logit_trace_agent = pygambit.lib.libgambit.logit_trace_agent
@@ -27,6 +27,7 @@ import math
 import numpy
 
 from . import pctrace
+from .lib import libgambit
 from .profiles import Solution
 from .nash import ExternalSolver
 
@@ -122,15 +123,49 @@ class LogitQRE(Solution):
         return 1.0 / self._lam
 
 
+def _strategic_qre(game, lam, probs):
+    """
+    Build a LogitQRE from the probabilities computed by the native tracer.
+    """
+    profile = game.mixed_strategy_profile()
+    for (i, p) in enumerate(probs):
+        profile[i] = p
+    return LogitQRE(lam, profile)
+
+
+def _behavior_qre(game, lam, probs):
+    """
+    Build a LogitQRE from the behavior probabilities computed by the native
+    tracer.
+    """
+    profile = game.mixed_behavior_profile()
+    for (i, p) in enumerate(probs):
+        profile[i] = p
+    return LogitQRE(lam, profile)
+
+
 class StrategicQREPathTracer:
     """
     Compute the principal branch of the logit QRE correspondence of 'game'.
+
+    Games implemented in the C++ library are traced natively, with the
+    interpreter lock released; other games are traced in Python, which is
+    supported for symmetric games.
     """
     def __init__(self):
         self.h_start = 0.03
         self.max_decel = 1.1
 
     def trace_strategic_path(self, game, max_lambda=1000000.0, callback=None):
+        if isinstance(game, libgambit.Game):
+            lams, profiles = libgambit.logit_trace_strategic(
+                game, max_lambda,
+                None if callback is None else
+                lambda lam, probs: callback(_strategic_qre(game, lam, probs))
+            )
+            return [_strategic_qre(game, lam, probs)
+                    for (lam, probs) in zip(lams, profiles)]
+
         def on_step(game, points, p, callback):
             qre = LogitQRE(
                 p[-1],
@@ -174,7 +209,14 @@ class StrategicQREPathTracer:
                         ))
             )
 
-        if game.is_symmetric:
+        if isinstance(game, libgambit.Game):
+            lam, probs = libgambit.logit_solve_strategic(
+                game, lam,
+                None if callback is None else
+                lambda x, probs: callback(_strategic_qre(game, x, probs))
+            )
+            return _strategic_qre(game, lam, probs)
+        elif game.is_symmetric:
             p = game.mixed_strategy_profile()
 
             point = pctrace.trace_path(
@@ -202,7 +244,15 @@ class StrategicQREPathTracer:
         def diff_log_like(data, point, tangent):
             return sum(x*y for (x, y) in zip(data, tangent[:-1]))
 
-        if game.is_symmetric:
+        if isinstance(game, libgambit.Game):
+            frequencies = game.mixed_strategy_profile()
+            for (i, x) in enumerate(data):
+                frequencies[i] = x
+            lam, probs, logL = libgambit.logit_estimate_strategic(frequencies)
+            qre = _strategic_qre(game, lam, probs)
+            qre.logL = logL
+            return qre
+        elif game.is_symmetric:
             p = game.mixed_strategy_profile()
 
             point = pctrace.trace_path(
@@ -293,6 +343,30 @@ class StrategicQREPathTracer:
             raise NotImplementedError
 
 
+class AgentQREPathTracer:
+    """
+    Compute the principal branch of the agent logit QRE correspondence of
+    the extensive game 'game', natively with the interpreter lock released.
+    """
+    def trace_agent_path(self, game, max_lambda=1000000.0, callback=None):
+        lams, profiles = libgambit.logit_trace_agent(
+            game, max_lambda,
+            None if callback is None else
+            lambda lam, probs: callback(_behavior_qre(game, lam, probs))
+        )
+        return [_behavior_qre(game, lam, probs)
+                for (lam, probs) in zip(lams, profiles)]
+
+    def compute_at_lambda(self, game, lam, callback=None):
+        lams, profiles = libgambit.logit_trace_agent(
+            game, max(1.0, 3.0*lam),
+            None if callback is None else
+            lambda x, probs: callback(_behavior_qre(game, x, probs)),
+            lam
+        )
+        return _behavior_qre(game, lams[-1], profiles[-1])
+
+
 class ExternalStrategicQREPathTracer(ExternalSolver):
     """
     Algorithm class to manage calls to external gambit-logit solver
@@ -95,6 +95,29 @@ class TestGambitGame(unittest.TestCase):
         game = pygambit.Game.read_game("test_games/not_perfect_recall.efg")
         assert not game.is_perfect_recall
 
+    def test_game_is_not_perfect_recall_member_order(self):
+        """To test that imperfect recall is detected when the information
+        set member not preceded by the player's earlier information set
+        comes first
+        """
+        game = pygambit.Game.read_game(
+            "test_games/not_perfect_recall_member_order.efg"
+        )
+        assert not game.is_perfect_recall
+
+    def test_game_write_nfg_reduced_form(self):
+        """To test that the strategic form of a tree is written the same
+        way before and after its reduced strategies are built
+        """
+        for filename in ["test_games/perfect_recall.efg",
+                         "test_games/complicated_extensive_game.efg",
+                         "test_games/sample_extensive_game.efg"]:
+            game = pygambit.Game.read_game(filename)
+            implicit = game.write(format="nfg")
+            # Looking up a strategy builds the strategies of all players
+            assert game.players[0].strategies[0].label
+            assert game.write(format="nfg") == implicit
+
     def test_game_behav_profile_error(self):
         """To test raising an error when trying to create a
         MixedBehavProfile from a game without a tree representation
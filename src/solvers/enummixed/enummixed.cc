@@ -20,6 +20,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
 #include "gambit.h"
 #include "solvers/linalg/vertenum.imp"
 #include "solvers/enummixed/enummixed.h"
@@ -30,6 +36,262 @@ namespace Nash {
 
 using namespace Gambit::linalg;
 
+namespace {
+
+///
+/// The set of labels of a vertex which are "tight", packed into words.
+/// Label k (1 <= k <= n1) refers to the k'th strategy of player 1, and
+/// label n1 + k to the k'th strategy of player 2.  A pair of vertices
+/// is complementary exactly when the union of their label sets is the
+/// set of all labels.
+///
+class LabelSet {
+public:
+  explicit LabelSet(int p_labels = 0) : m_words((p_labels + 63) / 64, 0) { }
+
+  void Set(int p_label)
+  { m_words[(p_label - 1) / 64] |= (uint64_t(1) << ((p_label - 1) % 64)); }
+
+  /// Returns true if the union of this set and the other is the full
+  /// set of labels (given as a LabelSet with all labels set).
+  bool Covers(const LabelSet &p_other, const LabelSet &p_full) const
+  {
+    for (size_t w = 0; w < m_words.size(); w++) {
+      if ((m_words[w] | p_other.m_words[w]) != p_full.m_words[w]) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::vector<uint64_t> m_words;
+};
+
+/// Whether a coordinate of a vertex might be zero, for the purposes of
+/// labelling.  In floating point, a pair of vertices is complementary when
+/// the products of corresponding coordinates are within 1e-15 of zero (see
+/// EnumMixedStrategySolver::EqZero).  Whenever such a product is, one of
+/// its factors is within sqrt(1e-15) of zero, so labelling with that
+/// looser tolerance finds every complementary pair; the products are then
+/// checked for the pairs found.  Rational labels are exact.
+inline bool MaybeZero(double x) { return std::fabs(x) <= std::sqrt(1.0e-15); }
+inline bool MaybeZero(const Rational &x) { return x == Rational(0); }
+inline bool IsExact(double) { return false; }
+inline bool IsExact(const Rational &) { return true; }
+
+/// Below this number of vertex pairs, checking pairs is not worth
+/// starting threads for.
+const long c_parallelThreshold = 1L << 16;
+
+/// The number of vertices of the second polytope held at once while
+/// pairing them against the first.
+const int c_batchSize = 1024;
+
+}  // end anonymous namespace
+
+//
+// The vertices of the first polytope are stored, with their label sets.
+// The vertices of the second polytope are passed to this callback as
+// they are found, collected into batches, and each batch is checked
+// against all vertices of the first polytope before being discarded.
+// Pairs are processed in the order the vertices are found, so the
+// output is the same as pairing two stored lists of vertices.
+//
+template <class T> class EnumMixedStrategySolver<T>::VertexPairer
+  : public VertexEnumerator<T>::VertexCallback {
+public:
+  VertexPairer(const EnumMixedStrategySolver<T> &p_solver,
+	       EnumMixedStrategySolution<T> &p_solution,
+	       const List<BFS<T> > &p_verts1);
+  ~VertexPairer() override = default;
+
+  void operator()(const BFS<T> &p_vertex, const BFS<T> &) override;
+  /// Pair all vertices remaining in the current batch
+  void Flush();
+
+private:
+  const EnumMixedStrategySolver<T> &m_solver;
+  EnumMixedStrategySolution<T> &m_solution;
+  Game m_game;
+  const List<BFS<T> > &m_verts1;
+  int m_n1, m_n2;
+  LabelSet m_full;
+  std::vector<LabelSet> m_labels1;
+  Array<int> m_vert1id;
+  int m_id1, m_id2, m_numVertices;
+
+  std::vector<BFS<T> > m_batch;
+  std::vector<LabelSet> m_batchLabels;
+
+  /// Checks the products of corresponding coordinates of the vertices
+  bool Complementary(const BFS<T> &p_bfs2, const BFS<T> &p_bfs1) const;
+  void ProcessPair(const BFS<T> &p_bfs1, int p_i1, int &p_vert2id);
+};
+
+template <class T>
+EnumMixedStrategySolver<T>::VertexPairer::VertexPairer(const EnumMixedStrategySolver<T> &p_solver,
+						       EnumMixedStrategySolution<T> &p_solution,
+						       const List<BFS<T> > &p_verts1)
+  : m_solver(p_solver), m_solution(p_solution), m_game(p_solution.GetGame()),
+    m_verts1(p_verts1),
+    m_n1(m_game->Players()[1]->Strategies().size()),
+    m_n2(m_game->Players()[2]->Strategies().size()),
+    m_full(m_n1 + m_n2),
+    m_labels1(p_verts1.Length() + 1, LabelSet(m_n1 + m_n2)),
+    m_vert1id(p_verts1.Length()),
+    m_id1(0), m_id2(0), m_numVertices(0)
+{
+  for (int k = 1; k <= m_n1 + m_n2; m_full.Set(k++));
+  for (int i = 1; i <= m_vert1id.Length(); m_vert1id[i++] = 0);
+
+  // A vertex of the first polytope (which gives player 2's strategy)
+  // is tight on label k if player 1's k'th strategy has zero slack,
+  // and on label n1 + k if player 2's k'th strategy has zero probability;
+  // symmetrically for vertices of the second polytope.
+  for (int i1 = 2; i1 <= m_verts1.Length(); i1++) {
+    const BFS<T> &bfs = m_verts1[i1];
+    for (int k = 1; k <= m_n1; k++) {
+      if (!bfs.count(-k) || MaybeZero(bfs[-k])) m_labels1[i1].Set(k);
+    }
+    for (int k = 1; k <= m_n2; k++) {
+      if (!bfs.count(k) || MaybeZero(bfs[k])) m_labels1[i1].Set(m_n1 + k);
+    }
+  }
+}
+
+template <class T>
+void EnumMixedStrategySolver<T>::VertexPairer::operator()(const BFS<T> &p_vertex,
+							  const BFS<T> &)
+{
+  // The first vertex found is the origin, which is never part of
+  // an equilibrium; it is kept so that vertex numbering is unchanged.
+  LabelSet labels(m_n1 + m_n2);
+  if (++m_numVertices > 1) {
+    for (int k = 1; k <= m_n1; k++) {
+      if (!p_vertex.count(k) || MaybeZero(p_vertex[k])) labels.Set(k);
+    }
+    for (int k = 1; k <= m_n2; k++) {
+      if (!p_vertex.count(-k) || MaybeZero(p_vertex[-k])) labels.Set(m_n1 + k);
+    }
+  }
+  m_batch.push_back(p_vertex);
+  m_batchLabels.push_back(labels);
+  if (m_batch.size() >= (size_t) c_batchSize) {
+    Flush();
+  }
+}
+
+template <class T> void EnumMixedStrategySolver<T>::VertexPairer::Flush()
+{
+  // Index within the batch of the first vertex which may be paired
+  int start = (m_numVertices - (int) m_batch.size() == 0) ? 1 : 0;
+  int size = m_batch.size();
+  int v1 = m_verts1.Length();
+
+  // Find the complementary pairs.  The batch is split into contiguous
+  // blocks, one per thread; each thread only reads the label sets, and
+  // the pairs are afterwards processed in the original order so the
+  // output does not depend on the number of threads.
+  int numThreads = 1;
+  if ((long) (size - start) * (long) v1 >= c_parallelThreshold) {
+    numThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, std::max(1, size - start));
+  }
+  std::vector<std::vector<std::pair<int, int> > > pairs(numThreads);
+  auto findPairs = [&](int p_block) {
+    int first = start + (long) (size - start) * p_block / numThreads;
+    int last = start + (long) (size - start) * (p_block + 1) / numThreads;
+    for (int i2 = first; i2 < last; i2++) {
+      for (int i1 = 2; i1 <= v1; i1++) {
+	if (m_batchLabels[i2].Covers(m_labels1[i1], m_full) &&
+	    (IsExact(T()) || Complementary(m_batch[i2], m_verts1[i1]))) {
+	  pairs[p_block].push_back(std::pair<int, int>(i2, i1));
+	}
+      }
+    }
+  };
+  if (numThreads == 1) {
+    findPairs(0);
+  }
+  else {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+      threads.push_back(std::thread(findPairs, t));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::vector<int> vert2id(size, 0);
+  for (const auto &block : pairs) {
+    for (const auto &pair : block) {
+      ProcessPair(m_batch[pair.first], pair.second, vert2id[pair.first]);
+    }
+  }
+  m_batch.clear();
+  m_batchLabels.clear();
+}
+
+template <class T>
+bool EnumMixedStrategySolver<T>::VertexPairer::Complementary(const BFS<T> &p_bfs2,
+							     const BFS<T> &p_bfs1) const
+{
+  for (int k = 1; k <= m_n1; k++) {
+    if (p_bfs2.count(k) && p_bfs1.count(-k) && !EqZero(p_bfs2[k] * p_bfs1[-k])) {
+      return false;
+    }
+  }
+  for (int k = 1; k <= m_n2; k++) {
+    if (p_bfs1.count(k) && p_bfs2.count(-k) && !EqZero(p_bfs1[k] * p_bfs2[-k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class T>
+void EnumMixedStrategySolver<T>::VertexPairer::ProcessPair(const BFS<T> &p_bfs1,
+							   int p_i1,
+							   int &p_vert2id)
+{
+  const BFS<T> &bfs2 = m_verts1[p_i1];
+
+  MixedStrategyProfile<T> profile(m_game->NewMixedStrategyProfile(static_cast<T>(0)));
+  static_cast<Vector<T> &>(profile) = static_cast<T>(0);
+  for (int k = 1; k <= m_n1; k++) {
+    if (p_bfs1.count(k)) {
+      profile[m_game->Players()[1]->Strategies()[k]] = -p_bfs1[k];
+    }
+  }
+  for (int k = 1; k <= m_n2; k++) {
+    if (bfs2.count(k)) {
+      profile[m_game->Players()[2]->Strategies()[k]] = -bfs2[k];
+    }
+  }
+  profile.Normalize();
+  m_solution.m_extremeEquilibria.push_back(profile);
+  m_solver.m_onEquilibrium->Render(profile);
+
+  // note: The keys give the mixed strategy associated with each node. 
+  //       The keys should also keep track of the basis
+  //       As things stand now, two different bases could lead to
+  //       the same key... BAD!
+  if (m_vert1id[p_i1] == 0) {
+    m_id1++;
+    m_vert1id[p_i1] = m_id1;
+    m_solution.m_key2.push_back(profile[m_game->GetPlayer(2)]);
+  }
+  if (p_vert2id == 0) {
+    m_id2++;
+    p_vert2id = m_id2;
+    m_solution.m_key1.push_back(profile[m_game->GetPlayer(1)]);
+  }
+  m_solution.m_node1.Append(p_vert2id);
+  m_solution.m_node2.Append(m_vert1id[p_i1]);
+}
+
 template <class T> List<List<MixedStrategyProfile<T> > > 
 EnumMixedStrategySolution<T>::GetCliques() const
 {
@@ -117,80 +379,17 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b1 = (T) -1;
   b2 = (T) -1;
 
-  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
+  // enumerate vertices of A1 x + b1 <= 0, and then the vertices of
+  // A2 x + b2 <= 0, which are paired with the former as they are found
   VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
-
   const List<BFS<T> > &verts1(poly1.VertexList());
-  const List<BFS<T> > &verts2(poly2.VertexList());
   solution->m_v1 = verts1.Length();
-  solution->m_v2 = verts2.Length();
-
-  Array<int> vert1id(solution->m_v1);
-  Array<int> vert2id(solution->m_v2);
-  for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
-  for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
-
-  int i = 0;
-  int id1 = 0, id2 = 0;
-
-  for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
-    for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
-	
-      // check if solution is nash 
-      // need only check complementarity, since it is feasible
-      bool nash = true;
-      for (size_t k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
-	if (bfs1.count(k) && bfs2.count(-k)) {
-	  nash = nash && EqZero(bfs1[k] * bfs2[-k]);
-	}
-      }
 
-      for (size_t k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
-	if (bfs2.count(k) && bfs1.count(-k)) {
-	  nash = nash && EqZero(bfs2[k] * bfs1[-k]);
-	}
-      }
+  VertexPairer pairer(*this, *solution, verts1);
+  VertexEnumerator<T> poly2(A2, b2, pairer);
+  pairer.Flush();
+  solution->m_v2 = poly2.NumVertices();
 
-      if (nash) {
-	MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
-	static_cast<Vector<T> &>(profile) = static_cast<T>(0);
-	for (size_t k = 1; k <= p_game->Players()[1]->Strategies().size(); k++) {
-	  if (bfs1.count(k)) {
-	    profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
-	  }
-	} 
-	for (size_t k = 1; k <= p_game->Players()[2]->Strategies().size(); k++) {
-	  if (bfs2.count(k)) {
-	    profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
-	  }
-	} 
-	profile.Normalize();
-	solution->m_extremeEquilibria.push_back(profile);
-	this->m_onEquilibrium->Render(profile);
-	  
-	// note: The keys give the mixed strategy associated with each node. 
-	//       The keys should also keep track of the basis
-	//       As things stand now, two different bases could lead to
-	//       the same key... BAD!
-	if (vert1id[i1] == 0) {
-	  id1++;
-	  vert1id[i1] = id1;
-	  solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
-	}
-	if (vert2id[i2] == 0) {
-	  id2++;
-	  vert2id[i2] = id2;
-	  solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
-	}
-	solution->m_node1.Append(vert2id[i2]);
-	solution->m_node2.Append(vert1id[i1]);
-      }
-    }
-  }
   return solution;
 }
 
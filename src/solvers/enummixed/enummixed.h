@@ -75,6 +75,9 @@ public:
   
   
 private:
+  /// Pairs vertices of the two polytopes as the second is enumerated
+  class VertexPairer;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
 };
@@ -141,13 +141,9 @@ class aggame : public gnmgame {
   private:
 
   //helper functions for computing jacobian
-    void computePartialP_PureNode(int player,int act,std::vector<int>& tasks);
-    void computePartialP_bisect(int player,int act, std::vector<int>::iterator f,std::vector<int>::iterator l,Gambit::agg::aggdistrib& temp);
-    void computePartialP(int player1, int act1, std::vector<int>& tasks,std::vector<int>& nontasks);
-    void computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Gambit::agg::trie_map<Gambit::agg::AggNumber>& cache);
+    void computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Gambit::agg::config_map<Gambit::agg::AggNumber>& cache);
     void savePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Gambit::agg::AggNumber result,
-		    Gambit::agg::trie_map<Gambit::agg::AggNumber>& cache, bool partial=false );
-    void computeUndisturbedPayoff(Gambit::agg::AggNumber& undisturbedPayoff,bool& has,int player1,int act1,int player2);
+		    Gambit::agg::config_map<Gambit::agg::AggNumber>& cache, bool partial=false );
 
 };
 
@@ -22,6 +22,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
 #include <cmath>
 #include <cfloat>
 #include "cmatrix.h"
@@ -124,7 +125,7 @@ int cmatrix::LUdecomp(cmatrix &LU, int *ix) const {
 	return d;
 }
 
-void cmatrix::LUbacksub(int *ix, double *b) const {
+void cmatrix::LUbacksub(const int *ix, double *b) const {
 	if (n!=m) {
 		std::cerr << "invalid cmatrix in LUbacksub" << std::endl;
 		exit(1);
@@ -517,5 +518,53 @@ double cmatrix::trace() {
   return sum;
 }
 
+lufactor::lufactor(int n, int maxUpdates)
+  : n(n), maxUpdates(maxUpdates), updates(0), detSign(0),
+    lu(n,n), ix(n), w(maxUpdates*n), v(maxUpdates*n) { }
+
+void lufactor::factor(const cmatrix &a) {
+	updates = 0;
+	detSign = a.LUdecomp(lu, ix.data());
+	// a pivot that is negligible against the entries of a is taken to be
+	// zero, as the solves would be meaningless
+	double scale = 0.0;
+	for(int i=0;i<n;i++)
+		for(int j=0;j<n;j++) scale = std::max(scale, fabs(a[i][j]));
+	for(int i=0;i<n;i++) {
+		if (fabs(lu[i][i])<=1.0e-12*scale) detSign = 0;
+		else if (lu[i][i]<0) detSign = -detSign;
+	}
+}
+
+bool lufactor::update(const cvector &u, const cvector &vec) {
+	if (updates==maxUpdates || detSign==0) return false;
+	cvector wu(n);
+	solve(u,wu);
+	double alpha = 1.0;
+	for(int i=0;i<n;i++) alpha += vec[i]*wu[i];
+	// a small denominator loses the accuracy of later solves
+	if (fabs(alpha)<1.0e-8) return false;
+
+	double *wk = &w[updates*n], *vk = &v[updates*n];
+	for(int i=0;i<n;i++) {
+		wk[i] = wu[i];
+		vk[i] = vec[i]/alpha;
+	}
+	if (alpha<0) detSign = -detSign;
+	updates++;
+	return true;
+}
+
+void lufactor::solve(const cvector &b, cvector &x) const {
+	for(int i=0;i<n;i++) x[i] = b[i];
+	lu.LUbacksub(ix.data(),x.values());
+	for(int k=0;k<updates;k++) {
+		const double *wk = &w[k*n], *vk = &v[k*n];
+		double dot = 0.0;
+		for(int i=0;i<n;i++) dot += vk[i]*x[i];
+		for(int i=0;i<n;i++) x[i] -= wk[i]*dot;
+	}
+}
+
 } // end namespace Gambit::gametracer
 } // end namespace Gambit
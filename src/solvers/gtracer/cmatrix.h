@@ -744,7 +744,7 @@ public:
 	int LUdecomp(cmatrix &LU, int *ix) const;
 	// LU back substitution --
 	//    ix from above fn call (this should be an LU combination)
-	void LUbacksub(int *ix, double *col) const;
+	void LUbacksub(const int *ix, double *col) const;
 
 	// solves equation Ax=b (A is this, x is the returned value)
 bool solve(cvector &b, cvector &dest);
@@ -868,6 +868,38 @@ inline std::istream& operator>>(std::istream& s, cmatrix& ma) {
 	return s;
 }
 
+// An LU factorization of a square matrix, which can be updated to that of
+// the matrix plus a rank-one term without refactoring.  The updates are
+// kept in product form: each stores w = A^{-1} u for the matrix A before
+// the update, and v scaled by 1/(1 + v^T w), so a solve applies them in
+// turn after the back substitution.  By the matrix determinant lemma, the
+// update multiplies the determinant by 1 + v^T w, so its sign is tracked
+// without the determinant itself, which may overflow.
+class lufactor {
+public:
+	lufactor(int n, int maxUpdates = 32);
+
+	// Factors a, discarding any updates
+	void factor(const cmatrix &a);
+	// Updates the factorization to that of A + u v^T.  Returns false if the
+	// update would make the factorization unreliable, or the number of
+	// updates has reached the maximum, in which case the matrix should be
+	// refactored instead.
+	bool update(const cvector &u, const cvector &v);
+	// Solves A x = b
+	void solve(const cvector &b, cvector &x) const;
+
+	// The sign of the determinant of A, or 0 if A is singular
+	inline int sign() const { return detSign; }
+	inline int numUpdates() const { return updates; }
+
+private:
+	int n, maxUpdates, updates, detSign;
+	cmatrix lu;
+	std::vector<int> ix;
+	std::vector<double> w, v;
+};
+
 }  // end namespace Gambit::gametracer
 }  // end namespace Gambit
  
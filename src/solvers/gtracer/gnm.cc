@@ -84,7 +84,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
   int N = A.getNumPlayers(), 
     M = A.getNumActions(); // the two most important cvector sizes, stored locally for brevity
   double bestPayoff, 
-    det, // determinant of the jacobian
+    det, // determinant of the jacobian, where it is singular
     newV, // utility variable
     lambda, // current position along the ray
     dlambda, // derivative of lambda w.r.t time
@@ -105,7 +105,19 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     R(M,M), // jacobian of the retraction operator
     I(M,M,1,true), // identity
     Dpsi, // jacobian of the cvector field
-    J(M,M); // adjoint of Dpsi
+    J(M,M); // Dpsi, when it is factored afresh, or its adjoint
+  lufactor LU(M); // factorization of Dpsi, with more than two players
+  // With two players, DG is constant, so Dpsi only changes with the
+  // support, by a term of rank one at each boundary.  The tangent to the
+  // path is found instead from the factorization T of Dpsi bordered by
+  // the column -g and a row, the tangent last followed.  T is updated at
+  // each boundary, and stays nonsingular where Dpsi does not, as the
+  // path enters a support on which lambda is constant.
+  lufactor T(M+1);
+  cmatrix K(M+1,M+1); // the bordered matrix
+  // Whether T is the factorization of the current bordered Dpsi; with
+  // more than two players, LU is refactored at each step
+  bool factored = false;
 
   cvector sigma(M), // current strategy profile
     g0(M), // original perturbation ray
@@ -115,7 +127,14 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     dv(M), // derivative of v w.r.t. time
     nothing(M,0),// cvector of all zeros
     err(M),
-    backup(M); 
+    backup(M),
+    t(M+1,0), // the last tangent, scaled
+    eM(M+1,0), // the last unit vector
+    tu(M+1,0), // scratch for T
+    tw(M+1,0),
+    tx(M+1,0);
+  eM[M] = 1.0;
+  t[M] = 1.0;
 
 
   // utility variables for use as intermediate values in computations
@@ -215,20 +234,79 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
     // take the specified number of steps within these support boundaries.  
     for(stepsLeft = steps; stepsLeft > 0; stepsLeft--) { 
-      //find J = Adj psi
-      J = I;
-      J += DG;
-      J *= R;
-      J -= I;
-      J.negate();
-      // J = I-((I+DG)*R);
-      det = J.adjoint(); // sets J = adjoint(J)
-
-      // find derivatives of z and lambda
-      J.multiply(g,dz);
-      dz.negate();      
-       //dz = -(J*g);
-      dlambda = -det;
+      //find J = D psi
+      if(!factored) {
+        J = I;
+        J += DG;
+        J *= R;
+        J -= I;
+        J.negate();
+        // J = I-((I+DG)*R);
+        if(N > 2) {
+          LU.factor(J);
+        }
+        else {
+          for(i = 0; i < M; i++) {
+            for(j = 0; j < M; j++)
+              K[i][j] = J[i][j];
+            K[i][M] = -g[i];
+          }
+          for(j = 0; j <= M; j++)
+            K[M][j] = t[j];
+          T.factor(K);
+          factored = true;
+        }
+      }
+      // find derivatives of z and lambda.  The tangent to the path is
+      // (-Adj(J)*g, -det(J)); the steps taken are the same for any
+      // positive multiple of it, as they are found from the distance to
+      // the next boundary along the tangent.  Where J is nonsingular,
+      // it is (J^{-1}*g, 1)*(-det(J)).  The solution x of K*x = eM spans
+      // the kernel of [J -g], as does the tangent, and the determinant
+      // of K is -t^T times the tangent, so the tangent is -x*det(K).
+      // Where neither is available, the adjoint is found.
+      if(N > 2 && LU.sign() != 0) {
+        LU.solve(g,dz);
+        dz *= -LU.sign();
+        //dz = -(J^{-1}*g)*sign(det(J));
+        dlambda = -LU.sign();
+      }
+      else if(N <= 2 && T.sign() != 0) {
+        // one step of iterative refinement keeps the accuracy of the
+        // tangent as the updates accumulate
+        T.solve(eM, tu);
+        K.multiply(tu, tw);
+        tw -= eM;
+        T.solve(tw, tx);
+        tu -= tx;
+        tu *= -T.sign();
+        for(i = 0; i < M; i++)
+          dz[i] = tu[i];
+        dlambda = tu[M];
+      }
+      else {
+        det = J.adjoint(); // sets J = adjoint(J)
+        J.multiply(g,dz);
+        dz.negate();
+        //dz = -(J*g);
+        dlambda = -det;
+        factored = false;
+      }
+      if(N <= 2) { // DEBUG
+        cmatrix JJ(M,M); JJ = I; JJ += DG; JJ *= R; JJ -= I; JJ.negate();
+        double dd = JJ.adjoint(); cvector q(M); JJ.multiply(g,q); q.negate();
+        double dot = -dd*dlambda; for(i=0;i<M;i++) dot += q[i]*dz[i];
+        static int cnt=0; cnt++;
+        if (dot <= 0) std::cerr << "MISMATCH " << cnt << " det " << dd << " dl " << dlambda << " upd " << T.numUpdates() << " f " << factored << std::endl;
+      }
+      if(N <= 2) {
+        // keep the tangent, to border the next factorization
+        for(i = 0; i < M; i++)
+          t[i] = dz[i];
+        t[M] = dlambda;
+        t /= max(t.max(), -t.min());
+      }
+
       R.multiply(dz, ym1);
       DG.multiply(ym1,dv);
       //dv = (DG*(R*dz));
@@ -310,8 +388,8 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	    J -= I; 
 	    J.negate();
 	    //J=I-((I+DG)*R);
-	    det = J.adjoint();
-	    ee = A.LNM(z, nothing, det, J, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
+	    LU.factor(J);
+	    ee = A.LNM(z, nothing, LU, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
 	  }
 	  for (int idx=0;idx<M;idx++)
 	    if (! std::isfinite(sigma[idx])){
@@ -396,7 +474,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
       // if we've done LNMMax repetitions, time to get back on the path
       if(stepsLeft > 1 && (++k == LNMFreq)) {
-	A.LNM(z, g0, det, J, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
+	A.LNM(z, g0, LU, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
 	k = 0;
       }
     } // end of for loop
@@ -411,6 +489,45 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	  s[n_hat] = i;
 	  break;
 	}
+    if(factored) {
+      // First border K with the tangent just followed, which is in the
+      // kernel of the rows above, so that the update is well conditioned,
+      // and K stays nonsingular unless the path turns back on itself.
+      for(j = 0; j <= M; j++) {
+	tw[j] = t[j] - K[M][j];
+	K[M][j] = t[j];
+      }
+      factored = T.update(eM, tw);
+
+      // The block of R for player n_hat is diag(b)-b*b^T/|b|, for b the
+      // indicator of the support.  Toggling s_hat changes it by
+      // +/- ks/(ks+1)*w*w^T, where w = b'/ks-e for b' the indicator of the
+      // rest of the support, of size ks, and e that of s_hat; so
+      // J = I-((I+DG)*R) changes by the rank one term -(I+DG)*that.
+      double dir = B[s_hat] ? -1.0 : 1.0, ks = 0.0;
+      for(i = A.firstAction(n_hat); i < A.lastAction(n_hat); i++)
+	if(B[i] && i != s_hat)
+	  ks += 1.0;
+      if(factored && ks > 0.0) {
+	for(i = 0; i < M; i++)
+	  ym2[i] = (B[i] && i != s_hat && i >= A.firstAction(n_hat) && i < A.lastAction(n_hat)) ? 1.0/ks : 0.0;
+	ym2[s_hat] = -1.0;
+	DG.multiply(ym2, err);
+	err += ym2;
+	err *= -dir * ks / (ks + 1.0);
+	for(i = 0; i < M; i++) {
+	  tu[i] = err[i];
+	  tw[i] = ym2[i];
+	}
+	tu[M] = tw[M] = 0.0;
+	factored = T.update(tu, tw);
+	for(i = 0; i < M; i++)
+	  for(j = 0; j < M; j++)
+	    K[i][j] += tu[i] * tw[j];
+      }
+      else
+	factored = false;
+    }
     B[s_hat] = !B[s_hat];
     A.retractJac(R,B);
     s_hat_old = s_hat;
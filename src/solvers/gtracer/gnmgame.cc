@@ -199,11 +199,11 @@ void gnmgame::KSymNormalizeStrategy(cvector& s){
   }
 }
 
-double gnmgame::LNM(cvector &z, const cvector &g, double det, cmatrix &J, cmatrix &DG, cvector &s, int MaxLNM, double fuzz, cvector &del, cvector &scratch, cvector &backup, bool ksym) {
+double gnmgame::LNM(cvector &z, const cvector &g, const lufactor &J, cmatrix &DG, cvector &s, int MaxLNM, double fuzz, cvector &del, cvector &scratch, cvector &backup, bool ksym) {
   double b, e = BIGFLOAT, ee;
   int k, faulted = 0;
-  if(MaxLNM >= 1 && det != 0.0) {
-    b = 1.0/det;
+  if(MaxLNM >= 1 && J.sign() != 0) {
+    b = 1.0;
     for(k = 0; k < MaxLNM; k++) {
       //      del = z - s - DG*s / (double)(numPlayers - 1) - g; 
       DG.multiply(s,del);
@@ -229,11 +229,11 @@ double gnmgame::LNM(cvector &z, const cvector &g, double det, cmatrix &J, cmatri
 	continue;
       }
       e = ee;
-      J.multiply(del, scratch);
+      J.solve(del, scratch);
       scratch *= b;
       backup = z;
       z -= scratch;
-      //      z = z - (J * del) * b;
+      //      z = z - (J^{-1} * del) * b;
       retract(s, z, ksym);
       payoffMatrix(DG, s, fuzz, ksym);
     }
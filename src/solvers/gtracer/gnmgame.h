@@ -157,10 +157,11 @@ class gnmgame {
 
   // LNM runs the local Newton method on z to attempt to bring it closer to
   // the image of the graph of the equilibrium correspondence above the ray,
-  // under the homeomorphism.  In order to prevent costly memory allocation,
-  // a number of scratch vectors are passed in.
+  // under the homeomorphism, taking Newton steps with the factorization J
+  // of the Jacobian at the start.  In order to prevent costly memory
+  // allocation, a number of scratch vectors are passed in.
 
-  double LNM(cvector &z, const cvector &g, double det, cmatrix &J, cmatrix &DG,  cvector &s, int MaxLNM, double fuzz, cvector &del, cvector &scratch, cvector &backup, bool ksym=false);
+  double LNM(cvector &z, const cvector &g, const lufactor &J, cmatrix &DG,  cvector &s, int MaxLNM, double fuzz, cvector &del, cvector &scratch, cvector &backup, bool ksym=false);
 
   // This normalizes a strategy profile by scaling appropriately.
   void normalizeStrategy(cvector &s);
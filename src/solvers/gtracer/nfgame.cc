@@ -23,18 +23,34 @@
 //
 
 #include <vector>
+#include <thread>
+#include <algorithm>
 #include "cmatrix.h"
 #include "nfgame.h"
 
 namespace Gambit {
 namespace gametracer {
 
+namespace {
+
+// Below this number of payoff entries, computing the Jacobian is not worth
+// starting threads for.
+const long c_parallelThreshold = 1L << 20;
+
+}  // end anonymous namespace
+
 nfgame::nfgame(int numPlayers, std::vector<int> &actions, const cvector &payoffs) : gnmgame(numPlayers, actions), payoffs(payoffs) {
   blockSize = new int[numPlayers + 1];
   blockSize[0] = 1;
   for(int i = 1; i <= numPlayers; i++) {
     blockSize[i] = blockSize[i-1]*actions[i-1];
   }
+  numThreads = 1;
+  if((long) blockSize[numPlayers] * numPlayers >= c_parallelThreshold) {
+    numThreads = std::min(numPlayers,
+			  std::max(1, (int) std::thread::hardware_concurrency()));
+  }
+  scratchSpace.resize(numThreads);
 }
 
 nfgame::~nfgame() {
@@ -48,127 +64,154 @@ int nfgame::findIndex(int player, std::vector<int> &s) {
   return retIndex;
 }
 
-double nfgame::getMixedPayoff(int player, cvector &s) {
-  auto *m = new double[blockSize[numPlayers]];
-  try {
-    memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
-    double p = localPayoff(s, m, numPlayers-1);
-    delete [] m;
-    return p;
+double *nfgame::scratch(int slot) {
+  std::vector<double> &space = scratchSpace[slot];
+  if(space.empty()) {
+    space.resize(4 * (size_t) blockSize[numPlayers]);
   }
-  catch (...) {
-    delete [] m;
-    throw;
+  return space.data();
+}
+
+double nfgame::getMixedPayoff(int player, cvector &s) {
+  const double *m = payoffs.values() + player * blockSize[numPlayers];
+  double *buf[2] = { scratch(0), scratch(0) + blockSize[numPlayers] };
+  for(int n = numPlayers-1, b = 0; n >= 0; n--, b = 1-b) {
+    contract(m, buf[b], 1, n, s);
+    m = buf[b];
   }
+  return *m;
 }
 
 void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
-  std::vector<double> t(payoffs.values()+player*blockSize[numPlayers], payoffs.values()+(player+1)*blockSize[numPlayers]);
-
-  localPayoffVector(dest.values(), player,const_cast<cvector&>(s),&(t[0]),numPlayers-1);
+  const double *m = payoffs.values() + player * blockSize[numPlayers];
+  double *buf[2] = { scratch(0), scratch(0) + blockSize[numPlayers] };
+  int k = 1, b = 0;
+  for(int n = numPlayers-1; n >= 0; n--) {
+    if(n == player) {
+      k = actions[player];
+    } else {
+      contract(m, buf[b], k, n, s);
+      m = buf[b];
+      b = 1-b;
+    }
+  }
+  for(int i = 0; i < actions[player]; i++) {
+    dest[i] = m[i];
+  }
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
-  int rown, coln, rowi, coli;
+  int rown, rowi, coli;
   double fuzzcount;
-  auto *m = new double[blockSize[numPlayers]];
-  auto *local = new double[maxActions*maxActions];
-  try {
-    for(rown = 0; rown < numPlayers; rown++) {
-      for(coln = 0; coln < numPlayers; coln++) {
-        if(rown == coln) {
-	  fuzzcount = fuzz;
-	  for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
-	      dest[rowi][coli]=fuzzcount;
-	      fuzzcount += fuzz;
-	    }
-	  }
-        } else {
-	  // set m to be the payoffs for player rown
-	  memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
-	  localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
-	  for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
-	      if(rown > coln) {
-	        dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
-	      } else {
-	        dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
-	      }
-	    }
-	  }
-        }
+  for(rown = 0; rown < numPlayers; rown++) {
+    fuzzcount = fuzz;
+    for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+      for(coli=firstAction(rown); coli < lastAction(rown); coli++) {
+	dest[rowi][coli]=fuzzcount;
+	fuzzcount += fuzz;
       }
     }
-    delete [] local;
-    delete [] m;
   }
-  catch (...) {
-    delete [] local;
-    delete [] m;
-    throw;
-  }
-}
-
 
-//assumes m = memcpy(m, payoffs + blockSize[numPlayers] * player1, blockSize[numPlayers]*sizeof(double)), player1 != player2
-//i.e. m points to payoff cmatrix for the desired player
-
-void nfgame::localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n) {
-  int i;
-  if(player1 == n) {
-    for(i = 0; i < actions[player1]; i++) {
-      localPayoffVector(dest+i*actions[player2], player2, s, m+i*blockSize[player1], n-1);
-    }
-  } else if(player2 == n) {
-    for(i = 0; i < actions[player2]; i++) {
-      localPayoffVector(dest+i*actions[player1], player1, s, m+i*blockSize[player2], n-1);
+  // Each thread fills the rows of every numThreads'th player; the blocks
+  // written are disjoint, and each thread has its own scratch space
+  if(numThreads == 1) {
+    for(rown = 0; rown < numPlayers; rown++) {
+      payoffBlocks(dest, rown, s, scratch(0));
     }
   } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffMatrix(dest, player1, player2, s, m, n-1);
+    for(int t = 0; t < numThreads; t++) {
+      scratch(t);
+    }
+    std::vector<std::thread> threads;
+    for(int t = 0; t < numThreads; t++) {
+      threads.push_back(std::thread([&, t]() {
+	    for(int pl = t; pl < numPlayers; pl += numThreads) {
+	      payoffBlocks(dest, pl, s, scratchSpace[t].data());
+	    }
+	  }));
+    }
+    for(auto &thread : threads) {
+      thread.join();
+    }
   }
 }
 
-double *nfgame::scaleMatrix(cvector &s, double *m, int n) {
-  int i,j, curbase, newbase = -1;
-  double scale;
-  for(i = 0; i < actions[n]; i++) {
-    if(s[i+firstAction(n)] > 0.0) {
-      scale = s[i+firstAction(n)];
-      curbase = i*blockSize[n];
-      if(newbase < 0) {
-	newbase = curbase;
-	for(j = curbase; j < curbase+blockSize[n]; j++) {
-	  m[j] *= scale;
-	}
+//
+// The block of the Jacobian for players player and coln holds the payoffs
+// to player of each pair of their actions, in expectation over the
+// actions of the others.  The expectations are taken over the players
+// from the highest index down.  Those over the players above coln are
+// shared by all the blocks of the row, so they are taken once, keeping
+// player's actions; the block for each coln is then found by keeping
+// coln's actions as well and taking the expectation over those below.
+//
+void nfgame::payoffBlocks(cmatrix &dest, int player, const cvector &s, double *space) {
+  int size = blockSize[numPlayers];
+  double *shared[2] = { space, space + size };
+  double *local[2] = { space + 2*size, space + 3*size };
+  const double *m = payoffs.values() + player * size;
+  int lowest = (player == 0) ? 1 : 0;
+  int k = 1, b = 0;
+
+  for(int coln = numPlayers-1; coln >= lowest; coln--) {
+    if(coln == player) {
+      // the tables are now also indexed by player's action, outermost
+      k *= actions[player];
+      continue;
+    }
+
+    const double *l = m;
+    int lk = k * actions[coln], lb = 0;
+    for(int n = coln-1; n >= 0; n--) {
+      if(n == player) {
+	lk *= actions[player];
       } else {
-	for(j = 0; j < blockSize[n]; j++) {
-	  m[newbase + j] += scale * m[curbase+j];
-	}
+	contract(l, local[lb], lk, n, s);
+	l = local[lb];
+	lb = 1-lb;
+      }
+    }
+    // the actions of whichever of player and coln has the higher index
+    // are outermost
+    for(int rowi = 0; rowi < actions[player]; rowi++) {
+      for(int coli = 0; coli < actions[coln]; coli++) {
+	dest[firstAction(player) + rowi][firstAction(coln) + coli] =
+	  (player > coln) ? l[rowi * actions[coln] + coli] : l[coli * actions[player] + rowi];
       }
     }
-  }
-  return m+newbase;
-}
 
-void nfgame::localPayoffVector(double *dest, int player, cvector &s, double *m, int n) {
-  if(player == n) {
-    for(int i = 0; i < actions[player]; i++) {
-      dest[i] = localPayoff(s, m+i*blockSize[player], n-1);
+    if(coln > lowest) {
+      contract(m, shared[b], k, coln, s);
+      m = shared[b];
+      b = 1-b;
     }
-  } else {
-    m = scaleMatrix(s, m, n);
-    localPayoffVector(dest, player, s, m, n-1);
   }
 }
 
-double nfgame::localPayoff(cvector &s, double *m, int n) {
-  if(n < 0)
-    return *m;
-  else {
-    m = scaleMatrix(s, m, n);
-    return localPayoff(s, m, n-1);
+void nfgame::contract(const double *in, double *out, int k, int n, const cvector &s) {
+  int bs = blockSize[n], first = firstAction(n);
+  for(int t = 0; t < k; t++, in += actions[n] * bs, out += bs) {
+    bool started = false;
+    for(int i = 0; i < actions[n]; i++) {
+      double scale = s[first + i];
+      if(scale > 0.0) {
+	const double *src = in + i*bs;
+	if(!started) {
+	  for(int j = 0; j < bs; j++) {
+	    out[j] = src[j] * scale;
+	  }
+	  started = true;
+	} else {
+	  for(int j = 0; j < bs; j++) {
+	    out[j] += scale * src[j];
+	  }
+	}
+      }
+    }
+    if(!started) {
+      std::fill(out, out + bs, 0.0);
+    }
   }
 }
 
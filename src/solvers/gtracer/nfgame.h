@@ -55,12 +55,19 @@ class nfgame : public gnmgame {
 
  private:
   int findIndex(int player, std::vector<int> &s);
-  void localPayoffMatrix(double *dest, int player1, int player2, cvector &s, double *m, int n);
-  void localPayoffVector(double *dest, int player, cvector &s, double *m, int n);
-  double localPayoff(cvector &s, double *m, int n);
-  double *scaleMatrix(cvector &s, double *m, int n);
+  // Takes the expectation over player n's actions in each of the k tables
+  // over the actions of players 0..n at in, writing k tables over the
+  // actions of players 0..n-1 to out
+  void contract(const double *in, double *out, int k, int n, const cvector &s);
+  // Fills all off-diagonal blocks of row player of the Jacobian, using the
+  // four tables of scratch space at space
+  void payoffBlocks(cmatrix &dest, int player, const cvector &s, double *space);
+  double *scratch(int slot);
   cvector payoffs;
   int *blockSize;
+  // Threads used by payoffMatrix, and the scratch space of each
+  int numThreads;
+  std::vector<std::vector<double> > scratchSpace;
 };
 
 inline std::ostream& operator<< (std::ostream& s, nfgame& g){
@@ -24,8 +24,7 @@
 #include <cstdio>
 #include <iostream>
 #include "gambit.h"
-#include "solvers/linalg/lemketab.h"
-#include "solvers/linalg/lhtab.h"
+#include "solvers/linalg/sparselemke.h"
 #include "solvers/lcp/lcp.h"
 
 namespace Gambit {
@@ -37,16 +36,22 @@ public:
   Rational maxpay;
   T eps;
   List<GameInfoset> isets1, isets2;
+  /// For each reachable information set, indexed by its position in
+  /// isets1 or isets2, the sequence leading to it, and the offset of the
+  /// sequences extending it by one of its actions
+  Array<int> parent1, parent2, start1, start2;
+  /// The position in isets1 or isets2 of each information set, by number
+  Array<int> index1, index2;
   List<Gambit::linalg::BFS<T> > m_list;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
-  bool AddBFS(const linalg::LemkeTableau<T> &);
+  bool AddBFS(const linalg::SparseLemkeTableau<T> &);
 
   int EquilibriumCount() const { return m_equilibria.size(); }
 };
 
 template <class T> bool 
-NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tableau)
+NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::SparseLemkeTableau<T> &tableau)
 {
   Gambit::linalg::BFS<T> cbfs;
   Vector<T> v(tableau.MinRow(), tableau.MaxRow());
@@ -67,6 +72,32 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tablea
   }
 }
 
+namespace {
+
+//
+// Numbers the sequences of player pl: the empty sequence is 1, and the
+// sequences extending the one leading to the i'th reachable information
+// set by each of its actions follow p_start[i].
+//
+void IndexSequences(const BehaviorSupportProfile &p_support, int pl,
+		    const List<GameInfoset> &p_isets, Array<int> &p_index,
+		    Array<int> &p_start, Array<int> &p_parent)
+{
+  p_index = Array<int>(p_support.GetGame()->GetPlayer(pl)->NumInfosets());
+  for (int i = 1; i <= p_index.Length(); p_index[i++] = 0);
+  p_start = Array<int>(p_isets.Length());
+  p_parent = Array<int>(p_isets.Length());
+  int snew = 1;
+  for (int i = 1; i <= p_isets.Length(); i++) {
+    p_index[p_isets[i]->GetNumber()] = i;
+    p_start[i] = snew;
+    p_parent[i] = 0;
+    snew += p_support.NumActions(pl, p_isets[i]->GetNumber());
+  }
+}
+
+}  // end anonymous namespace
+
 //
 // Lemke implements the Lemke's algorithm (as refined by Eaves 
 // for degenerate problems) for  Linear Complementarity
@@ -83,47 +114,66 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
-  Gambit::linalg::BFS<T> cbfs;
-  int i, j;
   Solution solution;
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
   solution.isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
 
-  int ntot;
   solution.ns1 = p_support.NumSequences(1);
   solution.ns2 = p_support.NumSequences(2);
   solution.ni1 = p_support.GetGame()->GetPlayer(1)->NumInfosets()+1;
   solution.ni2 = p_support.GetGame()->GetPlayer(2)->NumInfosets()+1;
+  IndexSequences(p_support, 1, solution.isets1, solution.index1,
+		 solution.start1, solution.parent1);
+  IndexSequences(p_support, 2, solution.isets2, solution.index2,
+		 solution.start2, solution.parent2);
 
-  ntot = solution.ns1+solution.ns2+solution.ni1+solution.ni2;
-
-  Matrix<T> A(1,ntot,0,ntot);
-  Vector<T> b(1,ntot);
+  int ns1 = solution.ns1, ns2 = solution.ns2, ni1 = solution.ni1;
+  int ntot = ns1 + ns2 + solution.ni1 + solution.ni2;
 
   solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
-  T prob = (T)1;
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) {
-    b[i] = (T) 0;
-    for (j = A.MinCol(); j <= A.MaxCol(); j++) {
-      A(i,j) = (T) 0; 
+  // The payoff entries are accumulated exactly over the leaves, and
+  // only then converted to the field the computation is done in
+  linalg::SparseMatrix<Rational> entries(1, ntot, 0, ntot);
+  FillTableau(p_support, entries, p_support.GetGame()->GetRoot(),
+	      Rational(1), 1, 1, solution);
+  for (int i1 = 1; i1 <= solution.isets1.Length(); i1++) {
+    if (solution.parent1[i1] == 0) continue;
+    int col = ns1 + ns2 + i1 + 1;
+    entries.Add(solution.parent1[i1], col, Rational(-1));
+    entries.Add(col, solution.parent1[i1], Rational(1));
+    for (int i = 1; i <= p_support.NumActions(1, solution.isets1[i1]->GetNumber()); i++) {
+      entries.Add(solution.start1[i1] + i, col, Rational(1));
+      entries.Add(col, solution.start1[i1] + i, Rational(-1));
     }
   }
-
-  FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
-	      solution);
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) { 
-    A(i,0) = -(T) 1;
+  for (int i2 = 1; i2 <= solution.isets2.Length(); i2++) {
+    if (solution.parent2[i2] == 0) continue;
+    int col = ns1 + ns2 + ni1 + i2 + 1;
+    entries.Add(ns1 + solution.parent2[i2], col, Rational(-1));
+    entries.Add(col, ns1 + solution.parent2[i2], Rational(1));
+    for (int i = 1; i <= p_support.NumActions(2, solution.isets2[i2]->GetNumber()); i++) {
+      entries.Add(ns1 + solution.start2[i2] + i, col, Rational(1));
+      entries.Add(col, ns1 + solution.start2[i2] + i, Rational(-1));
+    }
   }
-  A(1,solution.ns1+solution.ns2+1) = (T) 1;
-  A(solution.ns1+solution.ns2+1,1) = -(T) 1;
-  A(solution.ns1+1,solution.ns1+solution.ns2+solution.ni1+1) = (T) 1;
-  A(solution.ns1+solution.ns2+solution.ni1+1,solution.ns1+1) = -(T) 1;
-  b[solution.ns1+solution.ns2+1] = -(T)1;
-  b[solution.ns1+solution.ns2+solution.ni1+1] = -(T)1;
-
-  linalg::LemkeTableau<T> tab(A,b);
+  for (int i = 1; i <= ntot; i++) { 
+    entries.Add(i, 0, Rational(-1));
+  }
+  entries.Add(1, ns1+ns2+1, Rational(1));
+  entries.Add(ns1+ns2+1, 1, Rational(-1));
+  entries.Add(ns1+1, ns1+ns2+ni1+1, Rational(1));
+  entries.Add(ns1+ns2+ni1+1, ns1+1, Rational(-1));
+  entries.Compress();
+
+  linalg::SparseMatrix<T> A(entries);
+  Vector<T> b(1, ntot);
+  b = (T) 0;
+  b[ns1+ns2+1] = -(T)1;
+  b[ns1+ns2+ni1+1] = -(T)1;
+
+  linalg::SparseLemkeTableau<T> tab(A, b);
   solution.eps = tab.Epsilon();
   
   try {
@@ -170,8 +220,8 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 //
 template <class T> void
 NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
-				   int j, linalg::LemkeTableau<T> &B, int depth,
-				   Matrix<T> &A,
+				   int j, linalg::SparseLemkeTableau<T> &B, int depth,
+				   linalg::SparseMatrix<T> &A,
 				   Solution &p_solution) const
 {
   if (m_maxDepth != 0 && depth > m_maxDepth) {
@@ -187,7 +237,7 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
   for (int i = B.MinRow(); i <= B.MaxRow() && !newsol; i++) {
     if (i == j) continue;
 
-    linalg::LemkeTableau<T> BCopy(B);
+    linalg::SparseLemkeTableau<T> BCopy(B);
     A(i,0) = -small_num;
     BCopy.Refactor();
 
@@ -229,73 +279,64 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
   }
 }
 
+//
+// Adds the payoff entries of the sequence form for the subtree at the
+// node, reached with probability p_prob under sequences s1 and s2, and
+// records the sequence leading to each information set on the way.
+//
 template <class T>
 void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
-					const GameNode &n, T prob,
-					int s1, int s2, int i1, int i2,
-					Solution &p_solution) const
+					   linalg::SparseMatrix<Rational> &A,
+					   const GameNode &n, const Rational &p_prob,
+					   int s1, int s2,
+					   Solution &p_solution) const
 {
-  int snew;
   int ns1 = p_solution.ns1;
-  int ns2 = p_solution.ns2;
-  int ni1 = p_solution.ni1;
 
   GameOutcome outcome = n->GetOutcome();
   if (outcome) {
-    A(s1,ns1+s2) = Rational(A(s1,ns1+s2)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay);
-    A(ns1+s2,s1) = Rational(A(ns1+s2,s1)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay);
+    A.Add(s1, ns1+s2,
+	  p_prob * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay));
+    A.Add(ns1+s2, s1,
+	  p_prob * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay));
   }
-  if (n->GetInfoset()) {
-    if (n->GetPlayer()->IsChance()) {
-      GameInfoset infoset = n->GetInfoset();
-      for (int i = 1; i <= n->NumChildren(); i++) {
-	FillTableau(p_support, A, n->GetChild(i),
-		    Rational(prob) * infoset->GetActionProb(i, Rational(0)),
-		    s1, s2, i1, i2, p_solution);
-      }
+  if (!n->GetInfoset()) {
+    return;
+  }
+
+  GameInfoset infoset = n->GetInfoset();
+  int pl = n->GetPlayer()->GetNumber();
+  if (n->GetPlayer()->IsChance()) {
+    for (int i = 1; i <= n->NumChildren(); i++) {
+      FillTableau(p_support, A, n->GetChild(i),
+		  p_prob * infoset->GetActionProb(i, Rational(0)),
+		  s1, s2, p_solution);
     }
-    int pl = n->GetPlayer()->GetNumber();
-    if (pl==1) {
-      i1=p_solution.isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(p_solution.isets1[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets1[i]->GetNumber());
-      }
-      A(s1,ns1+ns2+i1+1) = -(T)1;
-      A(ns1+ns2+i1+1,s1) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(snew+i,ns1+ns2+i1+1) = (T)1;
-	A(ns1+ns2+i1+1,snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
-      }
+  }
+  else if (pl == 1) {
+    int i1 = p_solution.index1[infoset->GetNumber()];
+    p_solution.parent1[i1] = s1;
+    for (int i = 1; i <= p_support.NumActions(pl, infoset->GetNumber()); i++) {
+      FillTableau(p_support, A,
+		  n->GetChild(p_support.GetAction(pl, infoset->GetNumber(), i)->GetNumber()),
+		  p_prob, p_solution.start1[i1]+i, s2, p_solution);
     }
-    if(pl==2) {
-      i2=p_solution.isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(p_solution.isets2[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets2[i]->GetNumber());
-      }
-      A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
-      A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
-	A(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
-      }
+  }
+  else if (pl == 2) {
+    int i2 = p_solution.index2[infoset->GetNumber()];
+    p_solution.parent2[i2] = s2;
+    for (int i = 1; i <= p_support.NumActions(pl, infoset->GetNumber()); i++) {
+      FillTableau(p_support, A,
+		  n->GetChild(p_support.GetAction(pl, infoset->GetNumber(), i)->GetNumber()),
+		  p_prob, s1, p_solution.start2[i2]+i, p_solution);
     }
-    
   }
 }
 
 
 template <class T> void
 NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
-				     const linalg::LemkeTableau<T> &tab, 
+				     const linalg::SparseLemkeTableau<T> &tab, 
 				     MixedBehaviorProfile<T> &v, 
 				     const Vector<T> &sol,
 				     const GameNode &n, int s1, int s2,
@@ -314,11 +355,8 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
       }
     }
     else if (pl == 1) {
-      int inf = p_solution.isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, p_solution.isets1[i]->GetNumber()); 
-      }
+      int inf = p_solution.index1[iset];
+      int snew = p_solution.start1[inf];
       
       for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -339,11 +377,8 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
       }
     }
     else if (pl == 2) { 
-      int inf = p_solution.isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, p_solution.isets2[i]->GetNumber()); 
-      }
+      int inf = p_solution.index2[iset];
+      int snew = p_solution.start2[inf];
 
       for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
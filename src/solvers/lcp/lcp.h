@@ -29,7 +29,8 @@ namespace Gambit {
 
 namespace linalg {
 template <class T> class LHTableau;
-template <class T> class LemkeTableau;
+template <class T> class SparseMatrix;
+template <class T> class SparseLemkeTableau;
 }
 
 namespace Nash {
@@ -69,11 +70,11 @@ private:
 
   class Solution;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
-		   int, int, int, int, Solution &) const;
-  void AllLemke(const BehaviorSupportProfile &, int dup, Gambit::linalg::LemkeTableau<T> &B,
-	       int depth, Matrix<T> &, Solution &) const; 
-  void GetProfile(const BehaviorSupportProfile &, const Gambit::linalg::LemkeTableau<T> &tab, 
+  void FillTableau(const BehaviorSupportProfile &, linalg::SparseMatrix<Rational> &,
+		   const GameNode &, const Rational &, int, int, Solution &) const;
+  void AllLemke(const BehaviorSupportProfile &, int dup, linalg::SparseLemkeTableau<T> &B,
+	       int depth, linalg::SparseMatrix<T> &, Solution &) const; 
+  void GetProfile(const BehaviorSupportProfile &, const linalg::SparseLemkeTableau<T> &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
 		  const GameNode &n, int, int,
 		  Solution &) const;
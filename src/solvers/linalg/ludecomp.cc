@@ -26,10 +26,10 @@ namespace Gambit {
 
 namespace linalg {
 
-template class EtaMatrix<double>;
+template class SparseLU<double>;
 template class LUdecomp<double>;
 
-template class EtaMatrix<Rational>;
+template class SparseLU<Rational>;
 template class LUdecomp<Rational>;
 
 }  // end namespace Gambit::linalg
@@ -23,6 +23,7 @@
 #ifndef LUDECOMP_H
 #define LUDECOMP_H
 
+#include <vector>
 #include "gambit.h"
 #include "basis.h"
 
@@ -36,41 +37,105 @@ template <class T> class Tableau;
 // Class EtaMatrix
 // ---------------------------------------------------------------------------
 
+//
+// A sparse elementary matrix: the identity with the entries of one row
+// or one column replaced.  In the factors of SparseLU these are
+//   - column etas of L: the multipliers eliminating column `col' below
+//     pivot row `row';
+//   - columns of U: the diagonal entry `pivot' at (row, col), and the
+//     entries of rows pivoted earlier;
+//   - row etas of a Forrest-Tomlin update: the multiples of other rows
+//     subtracted from `row'.
+//
 template <class T> class EtaMatrix {
+public:
+  int row, col;
+  T pivot;
+  std::vector<std::pair<int, T> > entries;
+
+  EtaMatrix() : row(0), col(0), pivot(0) { }
+};
+
+// ---------------------------------------------------------------------------
+// Class SparseLU
+// ---------------------------------------------------------------------------
+
+//
+// A sparse LU factorization of a square matrix whose rows and columns
+// are both indexed first..last.  Factoring eliminates in Markowitz
+// order, so that sparse matrices have sparse factors; replacing a
+// column updates U in place using the Forrest-Tomlin update, which
+// appends one sparse row eta.  The cost of a solve is proportional to
+// the number of entries in the factors, plus the length of the vectors.
+//
+template <class T> class SparseLU {
+public:
+  typedef std::vector<std::pair<int, T> > Column;
+
+  class BadPivot : public Exception  {
   public:
-  int col;
-  Vector<T> etadata;
-  
-  EtaMatrix(int c, Vector<T> &v) : col(c), etadata(v) {}
+    virtual ~BadPivot() throw() { }
+    const char *what() const throw() { return "Bad pivot in LUdecomp"; }
+  };
+
+private:
+  int first, last;
+  std::vector< EtaMatrix<T> > L;   // column etas, in order of elimination
+  std::vector< EtaMatrix<T> > R;   // row etas from updates, in order
+  std::vector< EtaMatrix<T> > U;   // columns of U, by column index
+  std::vector< int > order;        // column indices in pivot order
+  long factor_entries;             // entries in L and U after factoring
+  long update_entries;             // entries in R
+
+  mutable Vector<T> scratch;
 
-  // required for list class
-  bool operator==(const EtaMatrix<T> &) const;
-  bool operator!=(const EtaMatrix<T> &) const;
+public:
+  // Start with the identity
+  SparseLU(int p_first, int p_last);
+
+  // factor the identity
+  void FactorIdentity();
+  // factor the matrix with the given columns, column j at index j - first
+  void Factor(const std::vector<Column> &);
+
+  // applies the column etas of L, then the row etas of R; the result
+  // for a column is the "spike" Update() takes
+  void Transform(Vector<T> &) const;
+  // replace column col by the column whose transform is given.  Returns
+  // false if the new pivot is zero or too small to be reliable, in which
+  // case the matrix must be factored afresh
+  bool Update(int col, const Vector<T> &spike);
+
+  // solve: B d = a
+  void Solve(const Vector<T> &a, Vector<T> &d) const;
+  // solve: y B = c
+  void SolveT(const Vector<T> &c, Vector<T> &y) const;
+
+  // entries in the row etas, and in the factors as last factored
+  long NumUpdateEntries() const { return update_entries; }
+  long NumFactorEntries() const { return factor_entries; }
 };
 
 // ---------------------------------------------------------------------------
 // Class LUdecomp
 // ---------------------------------------------------------------------------
 
+//
+// The factorization of the basis of a tableau, kept up to date as the
+// tableau pivots.
+//
 template <class T> class LUdecomp {
 private:
   Tableau<T> &tab;
   Basis &basis;
 
-  List< EtaMatrix<T> > L;
-  List< EtaMatrix<T> > U;
-  List< EtaMatrix<T> > E;
-  List< int > P;
+  SparseLU<T> lu;
 
   Vector<T> scratch1; // scratch vectors so we don't reallocate them
   Vector<T> scratch2; // everytime we do something.
 
   int refactor_number;
   int iterations;
-  int total_operations;
-
-  const LUdecomp<T> *parent;
-  int copycount;
 
   // don't use this copy constructor
   LUdecomp( const LUdecomp<T> &a);
@@ -80,16 +145,7 @@ private:
 
 
 public:
-  class BadPivot : public Exception  {
-  public:
-    virtual ~BadPivot() throw() { }
-    const char *what() const throw() { return "Bad pivot in LUdecomp"; }
-  };
-  class BadCount : public Exception  {
-  public:
-    virtual ~BadCount() throw() { }
-    const char *what() const throw() { return "Bad reference count in LUdecomp"; }
-  };
+  typedef typename SparseLU<T>::BadPivot BadPivot;
 
   // ------------------------
   // Constructors, Destructor
@@ -97,9 +153,6 @@ public:
     
 
   // copy constructor
-  // note:  Copying will fail an assertion if you try to update or delete
-  //        the original before the copy has been deleted, refactored
-  //        Or set to something else.
   LUdecomp( const LUdecomp<T> &, Tableau<T> & );
 
   // Decompose given matrix
@@ -128,7 +181,7 @@ public:
   // solve: y Bk = c
   void solveT( const Vector<T> &, Vector <T> & ) const;
 
-  // set number of etamatrices added before refactoring;
+  // set number of updates done before refactoring;
   // if number is set to zero, refactoring is done automatically.
   // if number is < 0, no refactoring is done;
   void SetRefactor( int );
@@ -139,33 +192,8 @@ public:
 
 private:
   
-  void FactorBasis();
-
-  void GaussElem( Matrix<T> &, int, int );
-
-  bool CheckBasis();
   bool RefactorCheck();
 
-  void BTransE( Vector<T> & ) const;
-  void FTransE( Vector<T> & ) const;
-  void BTransU( Vector<T> & ) const;
-  void FTransU( Vector<T> & ) const;
-  void LPd_Trans( Vector<T> & ) const;
-  void yLP_Trans( Vector<T> & ) const;
-
-  void VectorEtaSolve( const Vector<T> &v,  
-		      const EtaMatrix<T> &, 
-		      Vector<T> &y ) const;
-
-  void EtaVectorSolve( const Vector<T> &v, 
-		      const EtaMatrix<T> &,
-		      Vector<T> &d ) const;
-
-  void yLP_mult( const Vector<T> &y, int j, Vector<T> &) const;
-
-  void LPd_mult( Vector<T> &d, int j, Vector<T> &) const;
-
-
 };  // end of class LUdecomp
 
 }  // end namespace Gambit::linalg
@@ -173,13 +201,3 @@ private:
 }  // end namespace Gambit
  
 #endif // LUDECOMP_H
-
-
-
-
-
-
-
-
-
-
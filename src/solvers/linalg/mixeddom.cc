@@ -0,0 +1,297 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/solvers/linalg/mixeddom.cc
+// Elimination of strategies dominated by mixed strategies
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+
+#include "mixeddom.h"
+#include "lpsolve.h"
+
+namespace Gambit {
+
+namespace linalg {
+
+namespace {
+
+/// Tolerance used in deciding whether a floating-point LP optimum
+/// is less than one
+template <class T> T Tolerance();
+template<> double Tolerance() { return 1.0e-9; }
+template<> Rational Tolerance() { return Rational(0); }
+
+///
+/// The payoffs to a player's strategies in a support against each
+/// contingency of the other players, shifted to be positive.  These are
+/// held both exactly and as doubles.
+///
+class PayoffTable {
+public:
+  PayoffTable(const StrategySupportProfile &p_support, int p_player);
+
+  const Array<GameStrategy> &Strategies() const { return m_strategies; }
+
+  /// Is the strategy with the given index strictly dominated by a
+  /// mixture of the others in the table, computing in arithmetic T?
+  /// If so, p_weights holds the weights on strategies of a dominating
+  /// mixture, up to scale.
+  template <class T> bool SolveDominance(int p_strategy,
+					 Array<T> &p_weights) const;
+  /// Check exactly whether the strategy is strictly dominated by the
+  /// mixture with the given weights (up to scale)
+  bool VerifyDominance(int p_strategy, const Array<double> &p_weights) const;
+
+private:
+  Array<GameStrategy> m_strategies;
+  int m_contingencies;
+  std::vector<Rational> m_exact;
+  std::vector<double> m_double;
+
+  /// The payoff to the strategy with the given index against contingency c
+  template <class T> const T &Payoff(int p_strategy, int c) const;
+};
+
+template<> const double &PayoffTable::Payoff(int p_strategy, int c) const
+{ return m_double[(p_strategy - 1) * m_contingencies + c - 1]; }
+
+template<> const Rational &PayoffTable::Payoff(int p_strategy, int c) const
+{ return m_exact[(p_strategy - 1) * m_contingencies + c - 1]; }
+
+PayoffTable::PayoffTable(const StrategySupportProfile &p_support, int p_player)
+  : m_strategies(p_support.Strategies(p_support.GetGame()->GetPlayer(p_player))),
+    m_contingencies(1)
+{
+  for (int pl = 1; pl <= p_support.GetGame()->NumPlayers(); pl++) {
+    if (pl != p_player) {
+      m_contingencies *= p_support.NumStrategies(pl);
+    }
+  }
+  m_exact.resize(m_strategies.Length() * m_contingencies);
+  m_double.resize(m_strategies.Length() * m_contingencies);
+
+  Rational shift = Rational(1) - p_support.GetGame()->GetMinPayoff();
+  int c = 0;
+  for (StrategyProfileIterator iter(p_support, p_player, 1);
+       !iter.AtEnd(); iter++, c++) {
+    for (int st = 1; st <= m_strategies.Length(); st++) {
+      int index = (st - 1) * m_contingencies + c;
+      m_exact[index] = (*iter)->GetStrategyValue(m_strategies[st]) + shift;
+      m_double[index] = (double) m_exact[index];
+    }
+  }
+}
+
+//
+// Strategy s is strictly dominated by a mixture of the others exactly
+// when the program
+//   minimize sum_t x_t subject to sum_t x_t u(t, c) >= u(s, c), x >= 0,
+// has an optimum less than one, given positive payoffs u.  This has one
+// constraint per contingency c; its dual
+//   maximize sum_c y_c u(s, c) subject to sum_c y_c u(t, c) <= 1, y >= 0,
+// has one per other strategy t, and its origin is feasible.  Whichever
+// has fewer constraints is solved.
+//
+template <class T> bool PayoffTable::SolveDominance(int p_strategy,
+						     Array<T> &p_weights) const
+{
+  int others = m_strategies.Length() - 1;
+  if (others == 0) {
+    return false;
+  }
+  p_weights = Array<T>(m_strategies.Length());
+  for (int st = 1; st <= p_weights.Length(); p_weights[st++] = (T) 0);
+
+  if (m_contingencies < others) {
+    // In the form solved by LPSolve, maximize -sum_t x_t subject to
+    // -sum_t x_t u(t, c) <= -u(s, c)
+    Matrix<T> A(1, m_contingencies, 1, others);
+    Vector<T> b(1, m_contingencies);
+    Vector<T> cost(1, others);
+    for (int c = 1; c <= m_contingencies; c++) {
+      b[c] = -Payoff<T>(p_strategy, c);
+      for (int st = 1, col = 1; st <= m_strategies.Length(); st++) {
+	if (st == p_strategy)  continue;
+	A(c, col++) = -Payoff<T>(st, c);
+      }
+    }
+    cost = (T) -1;
+
+    LPSolve<T> lp(A, b, cost, 0);
+    if (!lp.IsFeasible() || !lp.IsBounded()) {
+      return false;
+    }
+    const BFS<T> &bfs = lp.OptimumBFS();
+    for (int st = 1, col = 1; st <= m_strategies.Length(); st++) {
+      if (st == p_strategy)  continue;
+      if (bfs.count(col)) {
+	p_weights[st] = bfs[col];
+      }
+      col++;
+    }
+    return (-lp.OptimumCost() < (T) 1 - Tolerance<T>());
+  }
+  else {
+    Matrix<T> A(1, others, 1, m_contingencies);
+    Vector<T> b(1, others);
+    Vector<T> cost(1, m_contingencies);
+    for (int st = 1, row = 1; st <= m_strategies.Length(); st++) {
+      if (st == p_strategy)  continue;
+      for (int c = 1; c <= m_contingencies; c++) {
+	A(row, c) = Payoff<T>(st, c);
+      }
+      row++;
+    }
+    b = (T) 1;
+    for (int c = 1; c <= m_contingencies; c++) {
+      cost[c] = Payoff<T>(p_strategy, c);
+    }
+
+    LPSolve<T> lp(A, b, cost, 0);
+    if (!lp.IsFeasible() || !lp.IsBounded()) {
+      return false;
+    }
+    // The weights of the mixture are the dual values of the constraints
+    const BFS<T> &bfs = lp.OptimumBFS();
+    for (int st = 1, row = 1; st <= m_strategies.Length(); st++) {
+      if (st == p_strategy)  continue;
+      if (bfs.count(-row)) {
+	p_weights[st] = bfs[-row];
+      }
+      row++;
+    }
+    return (lp.OptimumCost() < (T) 1 - Tolerance<T>());
+  }
+}
+
+bool PayoffTable::VerifyDominance(int p_strategy,
+				  const Array<double> &p_weights) const
+{
+  Array<Rational> weights(p_weights.Length());
+  Rational total(0);
+  for (int st = 1; st <= weights.Length(); st++) {
+    if (p_weights[st] < 0.0) {
+      return false;
+    }
+    weights[st] = Rational(p_weights[st]);
+    total += weights[st];
+  }
+  if (total == Rational(0)) {
+    return false;
+  }
+  
+  for (int c = 1; c <= m_contingencies; c++) {
+    Rational value(0);
+    for (int st = 1; st <= weights.Length(); st++) {
+      if (weights[st] != Rational(0)) {
+	value += weights[st] * Payoff<Rational>(st, c);
+      }
+    }
+    if (value <= total * Payoff<Rational>(p_strategy, c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+// Solving the programs exactly is much slower than in floating point, so
+// in exact arithmetic the program is first solved in floating point.
+// Only if the mixture found there fails to dominate exactly is the
+// program solved exactly.  A strategy which the floating-point test finds
+// undominated, which it can only be by a margin below its tolerance, is
+// retained.
+//
+template <class T> bool IsDominated(const PayoffTable &p_table, int p_strategy);
+
+template<> bool IsDominated<double>(const PayoffTable &p_table, int p_strategy)
+{
+  Array<double> weights;
+  return p_table.SolveDominance(p_strategy, weights);
+}
+
+template<> bool IsDominated<Rational>(const PayoffTable &p_table, int p_strategy)
+{
+  Array<double> weights;
+  if (!p_table.SolveDominance(p_strategy, weights)) {
+    return false;
+  }
+  if (p_table.VerifyDominance(p_strategy, weights)) {
+    return true;
+  }
+  Array<Rational> exact;
+  return p_table.SolveDominance(p_strategy, exact);
+}
+
+}  // end anonymous namespace
+
+template <class T>
+bool IsDominatedByMixed(const StrategySupportProfile &p_support,
+			const GameStrategy &p_strategy)
+{
+  PayoffTable table(p_support, p_strategy->GetPlayer()->GetNumber());
+  return IsDominated<T>(table, table.Strategies().Find(p_strategy));
+}
+
+template <class T>
+StrategySupportProfile UndominatedByMixed(const StrategySupportProfile &p_support)
+{
+  StrategySupportProfile support(p_support.IteratedUndominated(true));
+
+  while (true) {
+    bool removed = false;
+    for (int pl = 1; pl <= support.GetGame()->NumPlayers(); pl++) {
+      // With two strategies, a mixture is no stronger than the other
+      // strategy, which was dealt with by pure strategy dominance
+      if (support.NumStrategies(pl) <= 2) {
+	continue;
+      }
+      // Strategies are tested against the table for the support at the
+      // start of the pass; this is sound, since a strategy strictly
+      // dominated by a mixture remains so when other strictly dominated
+      // strategies are removed.
+      PayoffTable table(support, pl);
+      for (int st = 1; st <= table.Strategies().Length(); st++) {
+	if (IsDominated<T>(table, st)) {
+	  support.RemoveStrategy(table.Strategies()[st]);
+	  removed = true;
+	}
+      }
+    }
+    if (!removed) {
+      return support;
+    }
+    // Removing strategies for one player may have made further strategies
+    // of others dominated by pure strategies, which are cheap to find
+    support = support.IteratedUndominated(true);
+  }
+}
+
+template bool IsDominatedByMixed<double>(const StrategySupportProfile &,
+					 const GameStrategy &);
+template bool IsDominatedByMixed<Rational>(const StrategySupportProfile &,
+					   const GameStrategy &);
+template StrategySupportProfile
+UndominatedByMixed<double>(const StrategySupportProfile &);
+template StrategySupportProfile
+UndominatedByMixed<Rational>(const StrategySupportProfile &);
+
+}  // end namespace Gambit::linalg
+
+}  // end namespace Gambit
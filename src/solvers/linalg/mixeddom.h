@@ -0,0 +1,57 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/solvers/linalg/mixeddom.h
+// Elimination of strategies dominated by mixed strategies
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef MIXEDDOM_H
+#define MIXEDDOM_H
+
+#include "gambit.h"
+
+namespace Gambit {
+
+namespace linalg {
+
+///
+/// Returns true if the strategy is strictly dominated, within the
+/// support, by some mixture of the player's other strategies in the
+/// support.  This is decided by solving a linear program of one
+/// constraint for each of the other strategies.
+///
+template <class T>
+bool IsDominatedByMixed(const StrategySupportProfile &p_support,
+			const GameStrategy &p_strategy);
+
+///
+/// Returns the support which remains after iteratively eliminating
+/// strategies which are strictly dominated, either by another pure
+/// strategy or by a mixed strategy, until none remain.  As only strict
+/// dominance is used, the result does not depend on the order of
+/// elimination, and the Nash equilibria of the game restricted to the
+/// support are exactly those of the original game.
+///
+template <class T>
+StrategySupportProfile UndominatedByMixed(const StrategySupportProfile &p_support);
+
+}  // end namespace Gambit::linalg
+
+}  // end namespace Gambit
+ 
+#endif   // MIXEDDOM_H
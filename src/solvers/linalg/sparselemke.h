@@ -0,0 +1,127 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/solvers/linalg/sparselemke.h
+// Lemke's algorithm on a sparse linear complementarity problem
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSELEMKE_H
+#define GAMBIT_LINALG_SPARSELEMKE_H
+
+#include "btableau.h"
+#include "ludecomp.h"
+#include "sparsemat.h"
+
+namespace Gambit {
+namespace linalg {
+
+///
+/// A tableau for Lemke's algorithm which keeps the problem data as a
+/// sparse matrix and never forms the tableau itself.  The basis matrix is
+/// held as a SparseLU, which is built from the sparse columns of the
+/// basic variables and updated in place at each pivot.  Columns are
+/// indexed as in LemkeTableau: label 0 is column 0 of the matrix (the
+/// covering vector), positive labels are the other columns, and label -i
+/// is the slack of row i.
+///
+/// The pivoting rules are the same as LemkeTableau's, so that the two
+/// follow the same complementary paths.  Each pivot and each column
+/// solved costs time proportional to the entries in the factors, plus a
+/// pass over vectors of the length of a column, which the ratio test
+/// needs in any case.
+///
+template <class T> class SparseLemkeTableau {
+public:
+  class BadPivot : public Exception  {
+  public:
+    ~BadPivot() noexcept override = default;
+    const char *what() const noexcept override { return "Bad pivot in SparseLemkeTableau"; }
+  };
+  class BadExitIndex : public Exception  {
+  public:
+    ~BadExitIndex() noexcept override = default;
+    const char *what() const noexcept override { return "Bad exit index in SparseLemkeTableau"; }
+  };
+
+private:
+  const SparseMatrix<T> *m_A;
+  const Vector<T> *m_b;
+  /// The label basic at each position, and the position of each label
+  Array<int> m_label, m_position;
+  /// The basis matrix, whose columns are indexed by position
+  SparseLU<T> m_lu;
+  /// The basic solution, indexed by position
+  Vector<T> m_solution;
+  /// Work vectors, kept to avoid allocating one per operation
+  mutable Vector<T> m_work, m_incol, m_col, m_correction;
+  long m_npivots;
+  T m_eps1, m_eps2;
+
+  /// Writes the column of the given label into a vector indexed by row
+  void GetColumn(int p_label, Vector<T> &) const;
+  /// Solves for the basic solution from the current factors
+  void SolveBasis();
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Construct the tableau with all slacks basic
+  SparseLemkeTableau(const SparseMatrix<T> &A, const Vector<T> &b);
+  //@}
+
+  /// @name Basis information
+  //@{
+  int MinRow() const { return m_A->MinRow(); }
+  int MaxRow() const { return m_A->MaxRow(); }
+  int MinCol() const { return m_A->MinCol(); }
+  int MaxCol() const { return m_A->MaxCol(); }
+  /// Is the variable with the label basic?
+  bool Member(int p_label) const { return m_position[p_label] != 0; }
+  /// Returns the label basic in the position
+  int Label(int p_position) const { return m_label[p_position]; }
+  /// Returns the position of the basic label
+  int Find(int p_label) const { return m_position[p_label]; }
+  long NumPivots() const { return m_npivots; }
+  T Epsilon(int i = 2) const { return (i == 1) ? m_eps1 : m_eps2; }
+  //@}
+
+  /// @name Linear algebra
+  //@{
+  /// Puts the label into the basis in place of the variable at the position
+  void Pivot(int p_position, int p_label);
+  /// Writes the column of the label expressed in the current basis
+  void SolveColumn(int p_label, Vector<T> &) const;
+  /// Writes the current basic solution, indexed by position
+  void BasisVector(Vector<T> &) const;
+  /// Factors the basis afresh from the problem data
+  void Refactor();
+  //@}
+
+  /// @name Complementary pivoting
+  //@{
+  int SF_PivotIn(int i);
+  int SF_ExitIndex(int i);
+  /// Follows a path of almost-complementary bases to a complementary one
+  int SF_LCPPath(int dup);
+  //@}
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSELEMKE_H
@@ -0,0 +1,113 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/solvers/linalg/sparselp.h
+// Revised simplex method on a sparse linear program
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSELP_H
+#define GAMBIT_LINALG_SPARSELP_H
+
+#include "bfs.h"
+#include "ludecomp.h"
+#include "sparsemat.h"
+
+namespace Gambit {
+namespace linalg {
+
+///
+/// Solves the linear program maximize c x subject to A x <= b, x >= 0,
+/// where the last nequals constraints hold with equality, by the revised
+/// simplex method.  The problem and its results are as for LPSolve, and
+/// the two choose entering and leaving variables by the same rules.
+///
+/// The matrix is kept sparse and no tableau is formed.  The basis is held
+/// as a SparseLU, updated at each pivot, and the reduced costs are
+/// computed from the dual vector and the sparse columns.  A pivot then
+/// costs time proportional to the entries of the matrix and the factors,
+/// rather than to the product of the numbers of rows and columns.
+///
+/// Columns are labelled as in LPTableau: 1 to NumColumns() are the
+/// columns of the matrix, the following labels are the artificial
+/// variables of the rows with negative right-hand side, and label -i is
+/// the slack of row i.  All computation is done in the constructor.
+///
+template <class T> class SparseLPSolve {
+private:
+  const SparseMatrix<T> &m_A;
+  const Vector<T> &m_b;
+  int m_nvars, m_neqns, m_nequals;
+  bool m_feasible, m_bounded;
+  /// The row of each artificial variable, indexed by label
+  Array<int> m_artificial;
+  /// Bounds, current values and costs, indexed as in LPSolve: labels of
+  /// columns first, then the slack of row i at m_nvars + i
+  Array<bool> m_UB, m_LB;
+  Array<T> m_ub, m_lb;
+  Vector<T> m_xx, m_cost;
+  /// The label basic at each position, and the position of each label
+  Array<int> m_label, m_position;
+  SparseLU<T> m_lu;
+  /// The basic solution, indexed by position, and the dual vector,
+  /// indexed by row
+  Vector<T> m_solution, m_dual;
+  /// The entering column in terms of the basis, and work vectors
+  Vector<T> m_d, m_work, m_basisCost;
+  int m_flag;
+  T m_tmin, m_eps1, m_eps2;
+  /// The factor applied to the relative costs of columns (see CostScale)
+  T m_costScale;
+  long m_npivots;
+  BFS<T> m_optimum;
+
+  static int NumArtificials(const Vector<T> &);
+  int Index(int p_label) const
+  { return (p_label > 0) ? p_label : m_nvars - p_label; }
+  bool Member(int p_label) const
+  { return m_position[p_label] != 0; }
+
+  void GetColumn(int p_label, Vector<T> &) const;
+  void Refactor();
+  void SolveDual();
+  void Pivot(int p_position, int p_label);
+  T RelativeCost(int p_label) const;
+  T TotalCost() const;
+
+  void Solve(int phase);
+  int Enter();
+  int Exit(int);
+
+public:
+  SparseLPSolve(const SparseMatrix<T> &A, const Vector<T> &b,
+		const Vector<T> &c, int nequals);
+  ~SparseLPSolve() = default;
+
+  /// Returns the values of the basic columns at the optimum, together
+  /// with the dual values of the rows whose slacks are not basic, at
+  /// the negatives of their indices
+  const BFS<T> &OptimumBFS() const { return m_optimum; }
+
+  bool IsFeasible() const { return m_feasible; }
+  bool IsBounded() const  { return m_bounded; }
+  long NumPivots() const { return m_npivots; }
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSELP_H
@@ -0,0 +1,153 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2022, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/solvers/linalg/sparsemat.h
+// Matrix stored by sparse columns
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSEMAT_H
+#define GAMBIT_LINALG_SPARSEMAT_H
+
+#include <vector>
+#include <algorithm>
+#include "gambit.h"
+
+namespace Gambit {
+namespace linalg {
+
+///
+/// A matrix which stores only its nonzero entries, column by column.
+/// Entries are given as (row, column, value) triples with Add(); these
+/// are accumulated, so that a matrix can be assembled from contributions
+/// in any order, and are merged by Compress() before the matrix is used.
+///
+template <class T> class SparseMatrix {
+public:
+  typedef std::vector<std::pair<int, T> > Column;
+
+private:
+  int m_minrow, m_maxrow, m_mincol, m_maxcol;
+  std::vector<Column> m_columns;
+
+public:
+  /// @name Lifecycle
+  //@{
+  SparseMatrix(int p_minrow, int p_maxrow, int p_mincol, int p_maxcol)
+    : m_minrow(p_minrow), m_maxrow(p_maxrow),
+      m_mincol(p_mincol), m_maxcol(p_maxcol),
+      m_columns(p_maxcol - p_mincol + 1)
+  { }
+  /// Convert a matrix over another field, entry by entry
+  template <class U> explicit SparseMatrix(const SparseMatrix<U> &p_matrix)
+    : m_minrow(p_matrix.MinRow()), m_maxrow(p_matrix.MaxRow()),
+      m_mincol(p_matrix.MinCol()), m_maxcol(p_matrix.MaxCol()),
+      m_columns(p_matrix.MaxCol() - p_matrix.MinCol() + 1)
+  {
+    for (int j = m_mincol; j <= m_maxcol; j++) {
+      const typename SparseMatrix<U>::Column &column = p_matrix.GetColumn(j);
+      Column &target = m_columns[j - m_mincol];
+      target.reserve(column.size());
+      for (size_t k = 0; k < column.size(); k++) {
+	target.push_back(std::make_pair(column[k].first, (T) column[k].second));
+      }
+    }
+  }
+  //@}
+
+  /// @name Dimensions
+  //@{
+  int MinRow() const { return m_minrow; }
+  int MaxRow() const { return m_maxrow; }
+  int MinCol() const { return m_mincol; }
+  int MaxCol() const { return m_maxcol; }
+  int NumRows() const { return m_maxrow - m_minrow + 1; }
+  int NumColumns() const { return m_maxcol - m_mincol + 1; }
+  /// Returns the number of entries stored
+  long NumEntries() const
+  {
+    long count = 0;
+    for (size_t j = 0; j < m_columns.size(); count += m_columns[j++].size());
+    return count;
+  }
+  //@}
+
+  /// @name Building the matrix
+  //@{
+  /// Adds p_value to entry (i,j)
+  void Add(int i, int j, const T &p_value)
+  {
+    if (i < m_minrow || i > m_maxrow || j < m_mincol || j > m_maxcol) {
+      throw IndexException();
+    }
+    m_columns[j - m_mincol].push_back(std::make_pair(i, p_value));
+  }
+  /// Sorts each column by row, summing repeated entries and dropping zeros
+  void Compress()
+  {
+    for (size_t j = 0; j < m_columns.size(); j++) {
+      Column &column = m_columns[j];
+      std::stable_sort(column.begin(), column.end(),
+		       [](const std::pair<int, T> &a, const std::pair<int, T> &b)
+		       { return a.first < b.first; });
+      size_t last = 0;
+      for (size_t k = 0; k < column.size(); ) {
+	std::pair<int, T> entry = column[k++];
+	while (k < column.size() && column[k].first == entry.first) {
+	  entry.second += column[k++].second;
+	}
+	if (entry.second != (T) 0) {
+	  column[last++] = entry;
+	}
+      }
+      column.resize(last);
+    }
+  }
+  //@}
+
+  /// @name Accessing entries
+  //@{
+  /// Returns the entries of column j, sorted by row
+  const Column &GetColumn(int j) const { return m_columns[j - m_mincol]; }
+  /// Returns entry (i,j), which is zero if not stored
+  T operator()(int i, int j) const
+  {
+    const Column &column = m_columns[j - m_mincol];
+    auto entry = std::lower_bound(column.begin(), column.end(), i,
+				  [](const std::pair<int, T> &a, int row)
+				  { return a.first < row; });
+    return (entry != column.end() && entry->first == i) ? entry->second : (T) 0;
+  }
+  /// Returns a reference to entry (i,j), which must be stored
+  T &operator()(int i, int j)
+  {
+    Column &column = m_columns[j - m_mincol];
+    auto entry = std::lower_bound(column.begin(), column.end(), i,
+				  [](const std::pair<int, T> &a, int row)
+				  { return a.first < row; });
+    if (entry == column.end() || entry->first != i) {
+      throw IndexException();
+    }
+    return entry->second;
+  }
+  //@}
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSEMAT_H
@@ -38,11 +38,29 @@ namespace linalg {
 // where b <= 0.  Enumeration starts from the vertex y = 0.
 // All computation is done in the class constructor. The 
 // list of vertices can be accessed by VertexList()
+//
+// Alternatively, a VertexCallback can be passed to the constructor, in
+// which case each vertex is passed to the callback as it is found and
+// no list of vertices is kept.  The search itself holds only one
+// tableau per level of the search tree, so in this mode memory use is
+// bounded by the depth of the search rather than the number of vertices.
 //  
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
 template <class T> class VertexEnumerator {
+public:
+  //
+  // A function to call on each vertex found, with the primal and
+  // dual basic feasible solutions at the vertex
+  //
+  class VertexCallback {
+  public:
+    virtual ~VertexCallback() = default;
+    virtual void operator()(const BFS<T> &p_vertex,
+			    const BFS<T> &p_dual) = 0;
+  };
+
 private:
   int mult_opt,depth;
   int n;  // N is the number of columns, which is the # of dimensions.
@@ -53,8 +71,9 @@ private:
   Gambit::List<BFS<T> > List;
   Gambit::List<BFS<T> > DualList;
   Gambit::List<Vector<T> > Verts;
-  long npivots, nodes;
+  long npivots, nodes, nvertices;
   Gambit::List<long> visits,branches;
+  VertexCallback *m_callback;
 
   void Enum();
   void Deeper();
@@ -64,6 +83,7 @@ private:
 
 public:
   VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &, VertexCallback &);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
@@ -73,6 +93,7 @@ public:
   { return DualList; }
   void Vertices(Gambit::List<Vector<T> > &verts) const;
   long NumPivots() const { return npivots; }
+  long NumVertices() const { return nvertices; }
 };
 
 }  // end namespace Gambit::linalg
@@ -28,6 +28,7 @@
 #include <iomanip>
 
 #include "gambit.h"
+#include "solvers/linalg/mixeddom.h"
 #include "solvers/enummixed/enummixed.h"
 
 using namespace Gambit;
@@ -66,6 +67,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
+  std::cerr << "  -m               first eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies\n";
   std::cerr << "  -c               output connectedness information\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -77,7 +80,7 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
-  bool showConnect = false;
+  bool showConnect = false, reduce = false;
   int numDecimals = 6;
 
   int long_opt_index = 0;
@@ -86,7 +89,7 @@ int main(int argc, char *argv[])
     { "version", 0, nullptr, 'v'  },
     { nullptr,    0,    nullptr,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcSL", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqcmSL", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -106,6 +109,9 @@ int main(int argc, char *argv[])
     case 'c':
       showConnect = true;
       break;
+    case 'm':
+      reduce = true;
+      break;
     case 'S':
       break;
     case 'q':
@@ -146,6 +152,10 @@ int main(int argc, char *argv[])
     if (uselrs) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (reduce) {
+	game = linalg::UndominatedByMixed<Rational>(StrategySupportProfile(game)).Restrict();
+	renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+      }
       EnumMixedLrsStrategySolver solver(renderer);
       solver.Solve(game);
     }
@@ -153,6 +163,10 @@ int main(int argc, char *argv[])
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
+      if (reduce) {
+	game = linalg::UndominatedByMixed<double>(StrategySupportProfile(game)).Restrict();
+	renderer = new RestrictedStrategyRenderer<double>(renderer);
+      }
       EnumMixedStrategySolver<double> solver(renderer);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
@@ -165,6 +179,10 @@ int main(int argc, char *argv[])
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (reduce) {
+	game = linalg::UndominatedByMixed<Rational>(StrategySupportProfile(game)).Restrict();
+	renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+      }
       EnumMixedStrategySolver<Rational> solver(renderer);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
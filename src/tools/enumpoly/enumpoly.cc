@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <getopt.h>
 #include "gambit.h"
+#include "solvers/linalg/mixeddom.h"
 #include "nfghs.h"
 
 int g_numDecimals = 6;
@@ -52,6 +53,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
+  std::cerr << "  -m               first eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies (strategic games only)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows supports investigated)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -67,7 +70,7 @@ int main(int argc, char *argv[])
   opterr = 0;
 
   bool quiet = false;
-  bool useHeuristic = false, useStrategic = false;
+  bool useHeuristic = false, useStrategic = false, reduce = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -77,7 +80,7 @@ int main(int argc, char *argv[])
     { nullptr,    0,    nullptr,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHmSqvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -90,6 +93,9 @@ int main(int argc, char *argv[])
     case 'H':
       useHeuristic = true;
       break;
+    case 'm':
+      reduce = true;
+      break;
     case 'S':
       useStrategic = true;
       break;
@@ -136,6 +142,9 @@ int main(int argc, char *argv[])
     }
 
     if (!game->IsTree() || useStrategic) {
+      if (reduce) {
+	game = Gambit::linalg::UndominatedByMixed<double>(Gambit::StrategySupportProfile(game)).Restrict();
+      }
       if (useHeuristic) {
 	gbtNfgHs algorithm(0);
 	algorithm.Solve(game);
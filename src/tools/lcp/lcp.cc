@@ -26,6 +26,7 @@
 #include <cerrno>
 #include <getopt.h>
 #include "gambit.h"
+#include "solvers/linalg/mixeddom.h"
 #include "solvers/lcp/lcp.h"
 
 using namespace Gambit;
@@ -55,6 +56,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
+  std::cerr << "  -m               first eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies (strategic game only)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -66,7 +69,7 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
+  bool printDetail = false, reduce = false;
   int numDecimals = 6, stopAfter = 0, maxDepth = 0;
 
   int long_opt_index = 0;
@@ -75,7 +78,7 @@ int main(int argc, char *argv[])
     { "version", 0, nullptr, 'v'  },
     { nullptr,    0,    nullptr,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqmSPe:r:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -95,6 +98,9 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case 'm':
+      reduce = true;
+      break;
     case 'r':
       maxDepth = atoi(optarg);
       break;
@@ -146,6 +152,10 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
+	if (reduce) {
+	  game = linalg::UndominatedByMixed<double>(StrategySupportProfile(game)).Restrict();
+	  renderer = new RestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
 						renderer);
 	algorithm.Solve(game);
@@ -158,6 +168,10 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
+	if (reduce) {
+	  game = linalg::UndominatedByMixed<Rational>(StrategySupportProfile(game)).Restrict();
+	  renderer = new RestrictedStrategyRenderer<Rational>(renderer);
+	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
 						  renderer);
 	algorithm.Solve(game);
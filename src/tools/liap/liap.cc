@@ -51,6 +51,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -y               look for symmetric equilibria of a symmetric game\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "                   (default is to only show equilibria)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -133,6 +134,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
+  bool useSymmetric = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
@@ -147,7 +149,7 @@ int main(int argc, char *argv[])
     { nullptr,    0,    nullptr,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:hqVvSy", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -169,6 +171,9 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case 'y':
+      useSymmetric = true;
+      break;
     case 'V':
       verbose = true;
       break;
@@ -204,6 +209,9 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (useSymmetric && game->IsTree()) {
+      throw UndefinedException("Symmetric equilibria can only be computed for strategic games.");
+    }
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -220,7 +228,12 @@ int main(int argc, char *argv[])
 	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 							numDecimals);
 	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
+	if (useSymmetric) {
+	  algorithm.SolveSymmetric(starts[i]);
+	}
+	else {
+	  algorithm.Solve(starts[i]);
+	}
       }
     }
     else {
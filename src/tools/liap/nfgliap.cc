@@ -26,6 +26,7 @@
 
 #include "gambit.h"
 #include "core/function.h"
+#include "games/gametable.h"
 #include "nfgliap.h"
 
 using namespace Gambit;
@@ -102,6 +103,88 @@ double StrategicLyapunovFunction::Value(const Vector<double> &v) const
   return m_profile.GetLiapValue();
 }
 
+//------------------------------------------------------------------------
+//                    class SymmetricLyapunovFunction
+//------------------------------------------------------------------------
+
+//
+// The Lyapunov function of a symmetric profile, as a function of the
+// strategy common to all players, computed from the payoff function over
+// multisets of the others' strategies.  This is the Lyapunov function of
+// the full profile divided by the number of players.
+//
+class SymmetricLyapunovFunction : public FunctionOnSimplices {
+public:
+  SymmetricLyapunovFunction(const SymmetricPayoffTable &p_table)
+    : m_table(p_table), m_values(p_table.NumStrategies()),
+      m_derivs(p_table.NumStrategies(), p_table.NumStrategies())
+  { }
+  ~SymmetricLyapunovFunction() override = default;
+
+private:
+  const SymmetricPayoffTable &m_table;
+  mutable Vector<double> m_values;
+  mutable Matrix<double> m_derivs;
+
+  double Value(const Vector<double> &) const override;
+  bool Gradient(const Vector<double> &, Vector<double> &) const override;
+};
+
+double SymmetricLyapunovFunction::Value(const Vector<double> &v) const
+{
+  m_table.GetPayoffs(v, m_values);
+  double avg = 0.0, sum = 0.0, value = 0.0;
+  for (int st = 1; st <= v.Length(); st++) {
+    avg += v[st] * m_values[st];
+    sum += v[st];
+    if (v[st] < 0.0) {
+      value += 100.0 * v[st] * v[st];
+    }
+  }
+  for (int st = 1; st <= v.Length(); st++) {
+    if (m_values[st] > avg) {
+      value += (m_values[st] - avg) * (m_values[st] - avg);
+    }
+  }
+  return value + 100.0 * (sum - 1.0) * (sum - 1.0);
+}
+
+bool SymmetricLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
+{
+  m_table.GetPayoffs(v, m_values);
+  m_table.GetPayoffDerivs(v, m_derivs);
+  // a change in the common strategy changes those of the N-1 others
+  double others = m_table.NumPlayers() - 1;
+  int numStrats = v.Length();
+  double avg = 0.0, sum = 0.0;
+  for (int st = 1; st <= numStrats; st++) {
+    avg += v[st] * m_values[st];
+    sum += v[st];
+  }
+  for (int ell = 1; ell <= numStrats; ell++) {
+    // derivative of the average payoff with respect to v[ell]
+    double davg = m_values[ell];
+    for (int st = 1; st <= numStrats; st++) {
+      davg += v[st] * others * m_derivs(st, ell);
+    }
+    double x = 100.0 * (sum - 1.0);
+    for (int st = 1; st <= numStrats; st++) {
+      double regret = m_values[st] - avg;
+      if (regret > 0.0) {
+	x += regret * (others * m_derivs(st, ell) - davg);
+      }
+    }
+    if (v[ell] < 0.0) {
+      x += 100.0 * v[ell];
+    }
+    d[ell] = 2.0 * x;
+  }
+  Array<int> lengths(1);
+  lengths[1] = numStrats;
+  Project(d, lengths);
+  return true;
+}
+
 //------------------------------------------------------------------------
 //                     class NashLiapStrategySolver
 //------------------------------------------------------------------------
@@ -157,6 +240,75 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
   return solutions;
 }
 
+namespace {
 
+// Sets the strategy of each player to p_strategy
+void SetSymmetric(MixedStrategyProfile<double> &p_profile, const Vector<double> &p_strategy)
+{
+  for (int i = 1; i <= p_profile.MixedProfileLength(); i++) {
+    p_profile[i] = p_strategy[(i - 1) % p_strategy.Length() + 1];
+  }
+}
+
+}  // end anonymous namespace
+
+List<MixedStrategyProfile<double> >
+NashLiapStrategySolver::SolveSymmetric(const MixedStrategyProfile<double> &p_start) const
+{
+  const GameTableRep *game = dynamic_cast<const GameTableRep *>(&*p_start.GetGame());
+  if (!game) {
+    throw UndefinedException("Symmetric equilibria can only be computed for strategic games.");
+  }
+  SymmetricPayoffTable table(game->GetSymmetricPayoffs());
+  int numStrats = table.NumStrategies();
+
+  static const double ALPHA = .00000001;
+  List<MixedStrategyProfile<double> > solutions;
+
+  // The full profile in which all players play p
+  MixedStrategyProfile<double> profile(p_start);
+  Vector<double> p(numStrats);
+  GamePlayer player = p_start.GetGame()->GetPlayer(1);
+  for (int st = 1; st <= numStrats; st++) {
+    p[st] = p_start[player->GetStrategy(st)];
+  }
+  SetSymmetric(profile, p);
+  if (m_verbose) {
+    this->m_onEquilibrium->Render(profile, "start");
+  }
+
+  // if starting vector not interior, perturb it towards centroid
+  int kk;
+  for (kk = 1; kk <= numStrats && p[kk] > ALPHA; kk++);
+  if (kk <= numStrats) {
+    for (int k = 1; k <= numStrats; k++) {
+      p[k] = ALPHA / (double) numStrats + p[k] * (1.0-ALPHA);
+    }
+  }
+
+  SymmetricLyapunovFunction F(table);
+  ConjugatePRMinimizer minimizer(numStrats);
+  Vector<double> gradient(numStrats), dx(numStrats);
+  double fval;
+  minimizer.Set(F, p, fval, gradient, .01, .0001);
+
+  for (int iter = 1; iter <= m_maxitsN; iter++) {
+    if (!minimizer.Iterate(F, p, fval, gradient, dx)) {
+      break;
+    }
+
+    if (sqrt(gradient.NormSquared()) < .001) {
+      SetSymmetric(profile, p);
+      this->m_onEquilibrium->Render(profile, "NE");
+      solutions.push_back(profile);
+      break;
+    }
+  }
 
+  if (m_verbose && sqrt(gradient.NormSquared()) >= .001) {
+    SetSymmetric(profile, p);
+    this->m_onEquilibrium->Render(profile, "end");
+  }
 
+  return solutions;
+}
@@ -40,6 +40,10 @@ public:
   List<MixedStrategyProfile<double> > Solve(const MixedStrategyProfile<double> &p_start) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const override
     { return Solve(p_game->NewMixedStrategyProfile(0.0)); }
+  /// Looks for a symmetric equilibrium of a symmetric game, minimizing
+  /// over the strategy common to all players, starting from the strategy
+  /// of the first player in p_start
+  List<MixedStrategyProfile<double> > SolveSymmetric(const MixedStrategyProfile<double> &p_start) const;
 
 private:
   int m_maxitsN;
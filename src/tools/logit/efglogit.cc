@@ -254,9 +254,11 @@ AgentQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point,
 class AgentQREPathTracer::CallbackFunction : public PathTracer::CallbackFunction {
 public:
   CallbackFunction(std::ostream &p_stream,
-		   bool p_fullGraph, double p_decimals)
+		   bool p_fullGraph, double p_decimals,
+		   const PathTracer::CallbackFunction &p_observer)
     : m_stream(p_stream),
-      m_fullGraph(p_fullGraph), m_decimals(p_decimals) { }
+      m_fullGraph(p_fullGraph), m_decimals(p_decimals),
+      m_observer(p_observer) { }
   ~CallbackFunction() override = default;
 
   void operator()(const Vector<double> &p_point,
@@ -266,6 +268,7 @@ private:
   std::ostream &m_stream;
   bool m_fullGraph;
   double m_decimals;
+  const PathTracer::CallbackFunction &m_observer;
 };
 
 void AgentQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
@@ -290,6 +293,7 @@ void AgentQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
   }
 
   m_stream << std::endl;
+  m_observer(x, p_isTerminal);
 }
 
 //------------------------------------------------------------------------------
@@ -317,7 +321,8 @@ void
 AgentQREPathTracer::TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
 				   std::ostream &p_stream, 
 				   double p_maxLambda, 
-				   double p_omega, double p_targetLambda)
+				   double p_omega, double p_targetLambda,
+				   const PathTracer::CallbackFunction &p_observer)
 {
   Vector<double> x(p_start.BehaviorProfileLength() + 1);
   for (int i = 1; i <= p_start.BehaviorProfileLength(); i++) {
@@ -328,13 +333,13 @@ AgentQREPathTracer::TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
   if (p_targetLambda > 0.0) {
     TracePath(EquationSystem(p_start.GetGame()),
 	      x, p_maxLambda, p_omega,
-	      CallbackFunction(p_stream, m_fullGraph, m_decimals),
+	      CallbackFunction(p_stream, m_fullGraph, m_decimals, p_observer),
 	      LambdaCriterion(p_targetLambda));
   }
   else {
     TracePath(EquationSystem(p_start.GetGame()),
 	      x, p_maxLambda, p_omega,
-	      CallbackFunction(p_stream, m_fullGraph, m_decimals));
+	      CallbackFunction(p_stream, m_fullGraph, m_decimals, p_observer));
   }
 }
 
@@ -52,11 +52,15 @@ public:
   AgentQREPathTracer() : m_fullGraph(true), m_decimals(6) { }
   ~AgentQREPathTracer() override = default;
 
+  // The observer, if given, is passed each point reported on the path,
+  // as the logarithms of the action probabilities followed by lambda.
   void 
   TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
 		 std::ostream &p_stream,
 		 double p_maxLambda, double p_omega,
-		 double p_targetLambda=-1.0);
+		 double p_targetLambda=-1.0,
+		 const PathTracer::CallbackFunction &p_observer =
+		 NullCallbackFunction());
 
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
   bool GetFullGraph() const { return m_fullGraph; }
@@ -59,6 +59,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
+  std::cerr << "  -y               trace the branch of symmetric QRE of a symmetric game\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
 }
@@ -90,7 +91,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, useSymmetric = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "";
   double maxDecel = 1.1;
@@ -106,7 +107,7 @@ int main(int argc, char *argv[])
     { nullptr,    0,    nullptr,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSyL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -134,6 +135,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'y':
+      useSymmetric = true;
+      break;
     case 'L':
       mleFile = optarg;
       break;
@@ -176,6 +180,25 @@ int main(int argc, char *argv[])
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
 
+    if (useSymmetric) {
+      if (game->IsTree()) {
+	throw UndefinedException("Symmetric QRE can only be computed for strategic games.");
+      }
+      LogitQREMixedStrategyProfile start(game);
+      SymmetricQREPathTracer tracer;
+      tracer.SetMaxDecel(maxDecel);
+      tracer.SetStepsize(hStart);
+      tracer.SetFullGraph(fullGraph);
+      tracer.SetDecimals(decimals);
+      if (targetLambda > 0.0) {
+	tracer.SolveSymmetricAtLambda(start, std::cout, targetLambda, 1.0);
+      }
+      else {
+	tracer.TraceSymmetricPath(start, std::cout, maxLambda, 1.0);
+      }
+      return 0;
+    }
+
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
       MixedStrategyProfile<double> frequencies(game->NewMixedStrategyProfile(0.0));
       std::ifstream mleData(mleFile.c_str());
@@ -26,6 +26,7 @@
 #include <fstream>
 
 #include "gambit.h"
+#include "games/gametable.h"
 #include "nfglogit.h"
 
 namespace Gambit {
@@ -174,9 +175,11 @@ class StrategicQREPathTracer::CallbackFunction : public PathTracer::CallbackFunc
 public:
   CallbackFunction(std::ostream &p_stream,
 		   const Game &p_game,
-		   bool p_fullGraph, double p_decimals)
+		   bool p_fullGraph, double p_decimals,
+		   const PathTracer::CallbackFunction &p_observer)
     : m_stream(p_stream), m_game(p_game),
-      m_fullGraph(p_fullGraph), m_decimals(p_decimals) { }
+      m_fullGraph(p_fullGraph), m_decimals(p_decimals),
+      m_observer(p_observer) { }
   ~CallbackFunction() override = default;
   
   void operator()(const Vector<double> &p_point,
@@ -189,6 +192,7 @@ private:
   Game m_game;
   bool m_fullGraph;
   double m_decimals;
+  const PathTracer::CallbackFunction &m_observer;
   mutable List<LogitQREMixedStrategyProfile> m_profiles;
 };
 
@@ -215,6 +219,7 @@ StrategicQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
   }
   m_stream << std::endl;
   m_profiles.push_back(LogitQREMixedStrategyProfile(profile, x[x.Length()]));
+  m_observer(x, p_isTerminal);
 }
 
 //----------------------------------------------------------------------------
@@ -225,14 +230,16 @@ List<LogitQREMixedStrategyProfile>
 StrategicQREPathTracer::TraceStrategicPath(const LogitQREMixedStrategyProfile &p_start,
 					   std::ostream &p_stream,
 					   double p_maxLambda, 
-					   double p_omega) const
+					   double p_omega,
+					   const PathTracer::CallbackFunction &p_observer) const
 {
   Vector<double> x(p_start.MixedProfileLength() + 1);
   for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
     x[i] = log(p_start[i]);
   }
   x[x.Length()] = p_start.GetLambda();
-  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals,
+			p_observer);
   TracePath(EquationSystem(p_start.GetGame()),
 	    x, p_maxLambda, p_omega, func);
   return func.GetProfiles();
@@ -241,14 +248,16 @@ StrategicQREPathTracer::TraceStrategicPath(const LogitQREMixedStrategyProfile &p
 LogitQREMixedStrategyProfile
 StrategicQREPathTracer::SolveAtLambda(const LogitQREMixedStrategyProfile &p_start,
 				      std::ostream &p_stream,
-				      double p_targetLambda, double p_omega) const
+				      double p_targetLambda, double p_omega,
+				      const PathTracer::CallbackFunction &p_observer) const
 {
   Vector<double> x(p_start.MixedProfileLength() + 1);
   for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
     x[i] = log(p_start[i]);
   }
   x[x.Length()] = p_start.GetLambda();
-  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals,
+			p_observer);
   TracePath(EquationSystem(p_start.GetGame()),
 	    x, std::max(1.0, 3.0*p_targetLambda), p_omega,
 	    func,
@@ -256,6 +265,189 @@ StrategicQREPathTracer::SolveAtLambda(const LogitQREMixedStrategyProfile &p_star
   return func.GetProfiles().back();
 }
 
+//------------------------------------------------------------------------------
+//            SymmetricQREPathTracer: Classes representing equations
+//------------------------------------------------------------------------------
+
+class SymmetricQREPathTracer::EquationSystem : public PathTracer::EquationSystem {
+public:
+  EquationSystem(const SymmetricPayoffTable &p_table) : m_table(p_table) { }
+  ~EquationSystem() override = default;
+  // Compute the value of the system of equations at the specified point.
+  void GetValue(const Vector<double> &p_point,
+		Vector<double> &p_lhs) const override;
+  // Compute the Jacobian matrix at the specified point.
+  void GetJacobian(const Vector<double> &p_point,
+		   Matrix<double> &p_matrix) const override;
+
+private:
+  const SymmetricPayoffTable &m_table;
+};
+
+void
+SymmetricQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
+						 Vector<double> &p_lhs) const
+{
+  int numStrats = m_table.NumStrategies();
+  Vector<double> profile(numStrats), payoffs(numStrats);
+  for (int st = 1; st <= numStrats; st++) {
+    profile[st] = exp(p_point[st]);
+  }
+  double lambda = p_point[p_point.Length()];
+  m_table.GetPayoffs(profile, payoffs);
+
+  // The first equation is the sum-to-one equation, the others ratio equations
+  p_lhs[1] = -1.0;
+  for (int st = 1; st <= numStrats; st++) {
+    p_lhs[1] += profile[st];
+  }
+  for (int st = 2; st <= numStrats; st++) {
+    p_lhs[st] = (p_point[st] - p_point[1] - lambda * (payoffs[st] - payoffs[1]));
+  }
+}
+
+void
+SymmetricQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point,
+						    Matrix<double> &p_matrix) const
+{
+  int numStrats = m_table.NumStrategies();
+  Vector<double> profile(numStrats), payoffs(numStrats);
+  Matrix<double> derivs(numStrats, numStrats);
+  for (int st = 1; st <= numStrats; st++) {
+    profile[st] = exp(p_point[st]);
+  }
+  double lambda = p_point[p_point.Length()];
+  m_table.GetPayoffs(profile, payoffs);
+  m_table.GetPayoffDerivs(profile, derivs);
+  // The others all play the common strategy, so a change in it changes
+  // the strategies of N-1 players
+  double others = m_table.NumPlayers() - 1;
+
+  p_matrix = 0.0;
+  for (int m = 1; m <= numStrats; m++) {
+    p_matrix(m, 1) = profile[m];
+  }
+  for (int j = 2; j <= numStrats; j++) {
+    for (int m = 1; m <= numStrats; m++) {
+      p_matrix(m, j) = -lambda * others * profile[m] * (derivs(j, m) - derivs(1, m));
+    }
+    p_matrix(1, j) -= 1.0;
+    p_matrix(j, j) += 1.0;
+    // The last column is the derivative wrt lambda
+    p_matrix(p_matrix.NumRows(), j) = payoffs[1] - payoffs[j];
+  }
+}
+
+//----------------------------------------------------------------------------
+//               SymmetricQREPathTracer: Callback function
+//----------------------------------------------------------------------------
+
+class SymmetricQREPathTracer::CallbackFunction : public PathTracer::CallbackFunction {
+public:
+  CallbackFunction(std::ostream &p_stream,
+		   const Game &p_game,
+		   bool p_fullGraph, double p_decimals)
+    : m_stream(p_stream), m_game(p_game),
+      m_fullGraph(p_fullGraph), m_decimals(p_decimals) { }
+  ~CallbackFunction() override = default;
+
+  void operator()(const Vector<double> &p_point,
+		  bool p_isTerminal) const override;
+  const List<LogitQREMixedStrategyProfile> &GetProfiles() const
+  { return m_profiles; }
+
+private:
+  std::ostream &m_stream;
+  Game m_game;
+  bool m_fullGraph;
+  double m_decimals;
+  mutable List<LogitQREMixedStrategyProfile> m_profiles;
+};
+
+void
+SymmetricQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
+						     bool p_isTerminal) const
+{
+  if ((!m_fullGraph || p_isTerminal) && (m_fullGraph || !p_isTerminal)) {
+    return;
+  }
+  m_stream.setf(std::ios::fixed);
+  // By convention, we output lambda first
+  if (!p_isTerminal) {
+    m_stream << std::setprecision(m_decimals) << x[x.Length()];
+  }
+  else {
+    m_stream << "NE";
+  }
+  m_stream.unsetf(std::ios::fixed);
+  // The profile is written out in full, with each player playing the
+  // common strategy
+  MixedStrategyProfile<double> profile(m_game->NewMixedStrategyProfile(0.0));
+  int numStrats = x.Length() - 1;
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    profile[i] = exp(x[(i - 1) % numStrats + 1]);
+    m_stream << "," << std::setprecision(m_decimals) << profile[i];
+  }
+  m_stream << std::endl;
+  m_profiles.push_back(LogitQREMixedStrategyProfile(profile, x[x.Length()]));
+}
+
+//----------------------------------------------------------------------------
+//               SymmetricQREPathTracer: Main driver routines
+//----------------------------------------------------------------------------
+
+namespace {
+
+SymmetricPayoffTable GetSymmetricPayoffs(const Game &p_game)
+{
+  const GameTableRep *table = dynamic_cast<const GameTableRep *>(&*p_game);
+  if (!table) {
+    throw UndefinedException("Symmetric QRE can only be computed for strategic games.");
+  }
+  return table->GetSymmetricPayoffs();
+}
+
+// The starting point, from the strategy of the first player
+Vector<double> SymmetricStart(const LogitQREMixedStrategyProfile &p_start,
+			      const SymmetricPayoffTable &p_table)
+{
+  Vector<double> x(p_table.NumStrategies() + 1);
+  for (int st = 1; st <= p_table.NumStrategies(); st++) {
+    x[st] = log(p_start.GetProfile()[p_start.GetGame()->GetPlayer(1)->GetStrategy(st)]);
+  }
+  x[x.Length()] = p_start.GetLambda();
+  return x;
+}
+
+}  // end anonymous namespace
+
+List<LogitQREMixedStrategyProfile>
+SymmetricQREPathTracer::TraceSymmetricPath(const LogitQREMixedStrategyProfile &p_start,
+					   std::ostream &p_stream,
+					   double p_maxLambda,
+					   double p_omega) const
+{
+  SymmetricPayoffTable table(GetSymmetricPayoffs(p_start.GetGame()));
+  Vector<double> x(SymmetricStart(p_start, table));
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
+  TracePath(EquationSystem(table), x, p_maxLambda, p_omega, func);
+  return func.GetProfiles();
+}
+
+LogitQREMixedStrategyProfile
+SymmetricQREPathTracer::SolveSymmetricAtLambda(const LogitQREMixedStrategyProfile &p_start,
+					       std::ostream &p_stream,
+					       double p_targetLambda,
+					       double p_omega) const
+{
+  SymmetricPayoffTable table(GetSymmetricPayoffs(p_start.GetGame()));
+  Vector<double> x(SymmetricStart(p_start, table));
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
+  TracePath(EquationSystem(table), x, std::max(1.0, 3.0*p_targetLambda), p_omega,
+	    func, LambdaCriterion(p_targetLambda));
+  return func.GetProfiles().back();
+}
+
 //----------------------------------------------------------------------------
 //                 StrategicQREEstimator: Criterion function
 //----------------------------------------------------------------------------
@@ -301,7 +493,8 @@ public:
   CallbackFunction(std::ostream &p_stream,
 		   const Game &p_game,
 		   const Vector<double> &p_frequencies,
-		   bool p_fullGraph, double p_decimals);
+		   bool p_fullGraph, double p_decimals,
+		   const PathTracer::CallbackFunction &p_observer);
   ~CallbackFunction() override = default;
   
   void operator()(const Vector<double> &p_point,
@@ -319,6 +512,7 @@ private:
   const Vector<double> &m_frequencies;
   bool m_fullGraph;
   double m_decimals;
+  const PathTracer::CallbackFunction &m_observer;
   mutable MixedStrategyProfile<double> m_bestProfile;
   mutable double m_bestLambda;
   mutable double m_maxlogL;
@@ -327,9 +521,10 @@ private:
 StrategicQREEstimator::CallbackFunction::CallbackFunction(std::ostream &p_stream,
 							  const Game &p_game,
 							  const Vector<double> &p_frequencies,
-							  bool p_fullGraph, double p_decimals)
+							  bool p_fullGraph, double p_decimals,
+							  const PathTracer::CallbackFunction &p_observer)
   : m_stream(p_stream), m_game(p_game), m_frequencies(p_frequencies),
-    m_fullGraph(p_fullGraph), m_decimals(p_decimals),
+    m_fullGraph(p_fullGraph), m_decimals(p_decimals), m_observer(p_observer),
     m_bestProfile(p_game->NewMixedStrategyProfile(0.0)),
     m_bestLambda(0.0),
     m_maxlogL(LogLike(p_frequencies, m_bestProfile))
@@ -384,6 +579,7 @@ StrategicQREEstimator::CallbackFunction::operator()(const Vector<double> &x,
     m_bestLambda = x[x.Length()];
     m_bestProfile = profile;
   }
+  m_observer(x, p_isTerminal);
 }
 
 //----------------------------------------------------------------------------
@@ -394,7 +590,8 @@ LogitQREMixedStrategyProfile
 StrategicQREEstimator::Estimate(const LogitQREMixedStrategyProfile &p_start,
 				const MixedStrategyProfile<double> &p_frequencies,
 				std::ostream &p_stream,
-				double p_maxLambda, double p_omega)
+				double p_maxLambda, double p_omega,
+				const PathTracer::CallbackFunction &p_observer)
 {
   if (p_start.GetGame() != p_frequencies.GetGame()) {
     throw MismatchException();
@@ -407,7 +604,7 @@ StrategicQREEstimator::Estimate(const LogitQREMixedStrategyProfile &p_start,
   x[x.Length()] = p_start.GetLambda();
 
   CallbackFunction callback(p_stream, p_start.GetGame(),
-			    p_frequencies, m_fullGraph, m_decimals);
+			    p_frequencies, m_fullGraph, m_decimals, p_observer);
   while (x[x.Length()] < p_maxLambda) {
     TracePath(EquationSystem(p_start.GetGame()),
 	      x, p_maxLambda, p_omega,
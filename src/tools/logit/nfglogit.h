@@ -31,6 +31,7 @@ namespace Gambit {
 class LogitQREMixedStrategyProfile {
   friend class StrategicQREPathTracer;
   friend class StrategicQREEstimator;
+  friend class SymmetricQREPathTracer;
 public:
   LogitQREMixedStrategyProfile(const Game &p_game)
     : m_profile(p_game->NewMixedStrategyProfile(0.0)), m_lambda(0.0)
@@ -63,14 +64,20 @@ public:
     { }
   ~StrategicQREPathTracer() override = default;
 
+  // The observer, if given, is passed each point reported on the path,
+  // as the logarithms of the strategy probabilities followed by lambda.
   List<LogitQREMixedStrategyProfile> 
   TraceStrategicPath(const LogitQREMixedStrategyProfile &p_start,
 		     std::ostream &p_logStream,
-		     double p_maxLambda, double p_omega) const;
+		     double p_maxLambda, double p_omega,
+		     const PathTracer::CallbackFunction &p_observer =
+		     NullCallbackFunction()) const;
   LogitQREMixedStrategyProfile SolveAtLambda(const LogitQREMixedStrategyProfile &p_start,
 					     std::ostream &p_logStream,
 					     double p_targetLambda,
-					     double p_omega) const;
+					     double p_omega,
+					     const PathTracer::CallbackFunction &p_observer =
+					     NullCallbackFunction()) const;
   
   void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
   bool GetFullGraph() const { return m_fullGraph; }
@@ -97,13 +104,41 @@ public:
   Estimate(const LogitQREMixedStrategyProfile &p_start,
            const MixedStrategyProfile<double> &p_frequencies,
 	   std::ostream &p_logStream,
-	   double p_maxLambda, double p_omega);
+	   double p_maxLambda, double p_omega,
+	   const PathTracer::CallbackFunction &p_observer =
+	   NullCallbackFunction());
   
 protected:
   class CriterionFunction;
   class CallbackFunction;
 };
 
+//
+// Traces the branch of symmetric QREs of a symmetric game, on which all
+// players play the same strategy.  The equations are those for a single
+// player, with payoffs computed from the game's payoff function over
+// multisets of the others' strategies, so the cost of each step depends
+// on the number of such multisets rather than on the size of the table.
+//
+class SymmetricQREPathTracer : public StrategicQREPathTracer {
+public:
+  SymmetricQREPathTracer() = default;
+  ~SymmetricQREPathTracer() override = default;
+
+  List<LogitQREMixedStrategyProfile>
+  TraceSymmetricPath(const LogitQREMixedStrategyProfile &p_start,
+		     std::ostream &p_logStream,
+		     double p_maxLambda, double p_omega) const;
+  LogitQREMixedStrategyProfile
+  SolveSymmetricAtLambda(const LogitQREMixedStrategyProfile &p_start,
+			 std::ostream &p_logStream,
+			 double p_targetLambda, double p_omega) const;
+
+protected:
+  class EquationSystem;
+  class CallbackFunction;
+};
+
 }  // end namespace Gambit
  
 #endif // NFGLOGIT_H
@@ -23,7 +23,7 @@
 #include <cstdio>
 #include <iostream>
 #include "gambit.h"
-#include "solvers/linalg/lpsolve.h"
+#include "solvers/linalg/sparselp.h"
 #include "efglp.h"
 
 using namespace Gambit;
@@ -34,11 +34,14 @@ public:
   int ns1, ns2, ni1, ni2;
   Rational minpay;
   PVector<int> infosetIndex, infosetOffset;
+  /// The sequence leading to each reachable information set, once the
+  /// set's constraint has been entered in the matrix
+  PVector<int> infosetParent;
   
   GameData(const BehaviorSupportProfile &);
 
   void BuildConstraintMatrix(const BehaviorSupportProfile &,
-			     Matrix<T> &, const GameNode &, const T &,
+			     linalg::SparseMatrix<T> &, const GameNode &, const T &,
 			     int, int, int, int);
   void GetBehavior(const BehaviorSupportProfile &, MixedBehaviorProfile<T> &v,
 		   const Array<T> &, const Array<T> &,
@@ -48,10 +51,12 @@ public:
 template <class T>
 NashLpBehavSolver<T>::GameData::GameData(const BehaviorSupportProfile &p_support)
   : infosetIndex(p_support.GetGame()->NumInfosets()), 
-    infosetOffset(p_support.GetGame()->NumInfosets())
+    infosetOffset(p_support.GetGame()->NumInfosets()),
+    infosetParent(p_support.GetGame()->NumInfosets())
 {
   infosetIndex = 0;
   infosetOffset = 0;
+  infosetParent = 0;
   ns1 = p_support.NumSequences(1);
   ns2 = p_support.NumSequences(2);
   ni1 = p_support.GetGame()->GetPlayer(1)->NumInfosets()+1;  
@@ -75,11 +80,14 @@ NashLpBehavSolver<T>::GameData::GameData(const BehaviorSupportProfile &p_support
 }
 
 //
-// Recursively fills the constraint matrix A for the subtree rooted at 'n'.
+// Recursively adds the entries of the constraint matrix A for the subtree
+// rooted at 'n'.  Payoffs are summed over the terminal nodes reached by
+// each pair of sequences; the constraint of each information set is
+// entered the first time one of its members is reached.
 //
 template <class T> void
 NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfile &p_support,
-						      Matrix<T> &A, 
+						      linalg::SparseMatrix<T> &A, 
 						      const GameNode &n, 
 						      const T &prob,
 						      int s1, int s2, 
@@ -87,8 +95,8 @@ NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfi
 {
   GameOutcome outcome = n->GetOutcome();
   if (outcome) {
-    A(s1,s2) += 
-      (T) (Rational(prob) * outcome->GetPayoff<Rational>(1) - minpay);
+    A.Add(s1, s2,
+	  (T) (Rational(prob) * outcome->GetPayoff<Rational>(1) - minpay));
   }
 
   if (n->NumChildren() == 0) {
@@ -107,9 +115,15 @@ NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfi
   else if (n->GetPlayer()->GetNumber() == 1) {
     i1 = infosetIndex(1, n->GetInfoset()->GetNumber());
     int snew = infosetOffset(1, n->GetInfoset()->GetNumber());
-    A(s1, ns2+i1+1) = (T) 1;
+    bool first = (infosetParent(1, n->GetInfoset()->GetNumber()) == 0);
+    if (first) {
+      infosetParent(1, n->GetInfoset()->GetNumber()) = s1;
+      A.Add(s1, ns2+i1+1, (T) 1);
+    }
     for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      A(snew+i, ns2+i1+1) = (T) -1;
+      if (first) {
+	A.Add(snew+i, ns2+i1+1, (T) -1);
+      }
       BuildConstraintMatrix(p_support, A, 
 			    n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
 			    prob, snew+i, s2, i1, i2);
@@ -118,9 +132,15 @@ NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfi
   else {  // Must be player 2
     i2 = infosetIndex(2, n->GetInfoset()->GetNumber());
     int snew = infosetOffset(2, n->GetInfoset()->GetNumber());
-    A(ns1+i2+1, s2) = (T) -1;
+    bool first = (infosetParent(2, n->GetInfoset()->GetNumber()) == 0);
+    if (first) {
+      infosetParent(2, n->GetInfoset()->GetNumber()) = s2;
+      A.Add(ns1+i2+1, s2, (T) -1);
+    }
     for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      A(ns1+i2+1, snew+i) = (T) 1;
+      if (first) {
+	A.Add(ns1+i2+1, snew+i, (T) 1);
+      }
       BuildConstraintMatrix(p_support, A, 
 			    n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
 			    prob, s1, snew+i, i1, i2);
@@ -143,12 +163,12 @@ NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfi
 // replace this function.
 //
 template <class T> bool
-NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A, 
+NashLpBehavSolver<T>::SolveLP(const linalg::SparseMatrix<T> &A, 
 			      const Vector<T> &b, const Vector<T> &c,
 			      int nequals,
 			      Array<T> &p_primal, Array<T> &p_dual) const
 {
-  Gambit::linalg::LPSolve<T> LP(A, b, c, nequals);
+  Gambit::linalg::SparseLPSolve<T> LP(A, b, c, nequals);
   const Gambit::linalg::BFS<T> &cbfs(LP.OptimumBFS());
   
   for (int i = 1; i <= A.NumColumns(); i++) {
@@ -247,22 +267,20 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
 
-  Gambit::linalg::BFS<T> cbfs;
-  
   GameData data(p_support.GetGame());
 
-  Matrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
+  linalg::SparseMatrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
   Vector<T> b(1, data.ns1 + data.ni2);
   Vector<T> c(1, data.ns2 + data.ni1);
 
-  A = (T) 0;
   b = (T) 0;
   c = (T) 0;
 
   data.BuildConstraintMatrix(p_support, A, p_support.GetGame()->GetRoot(), 
 			     (T) 1, 1, 1, 0, 0);
-  A(1, data.ns2 + 1) = (T) -1;
-  A(data.ns1 + 1, 1) = (T) 1;
+  A.Add(1, data.ns2 + 1, (T) -1);
+  A.Add(data.ns1 + 1, 1, (T) 1);
+  A.Compress();
 
   b[data.ns1 + 1] = (T) 1;
   c[data.ns2 + 1] = (T) -1;
@@ -24,6 +24,7 @@
 #define LP_EFGLP_H
 
 #include "games/nash.h"
+#include "solvers/linalg/sparsemat.h"
 
 using namespace Gambit;
 using namespace Gambit::Nash;
@@ -39,7 +40,8 @@ public:
 private:
   class GameData;
 
-  virtual bool SolveLP(const Matrix<T> &, const Vector<T> &, const Vector<T> &,
+  virtual bool SolveLP(const Gambit::linalg::SparseMatrix<T> &,
+		       const Vector<T> &, const Vector<T> &,
 		       int, Array<T> &, Array<T> &) const;
 };
 